@@ -12,6 +12,7 @@ public class EpicWizardGame : ModuleRules
 			"Core",
 			"CoreUObject",
 			"Engine",
+			"RenderCore",
 			"InputCore",
 			"EnhancedInput",
 			"AIModule",
@@ -5,4 +5,7 @@
 #include "CoreMinimal.h"
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogEpicWizardGame, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogEpicWizardGame, Log, All);
+
+/** Object channel for zombie capsules when they use separation steering instead of pawn-pawn blocking */
+#define ECC_Zombie ECC_GameTraceChannel2
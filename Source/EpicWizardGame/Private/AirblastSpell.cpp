@@ -3,14 +3,23 @@
 #include "AirblastSpell.h"
 #include "WizardCharacter.h"
 #include "ZombieCharacter.h"
+#include "GameplayTimerSubsystem.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "GameplayScratch.h"
+#include "SimulationStepSubsystem.h"
+#include "CosmeticEffectSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
-#include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Engine/DamageEvents.h"
 
+namespace
+{
+	/** BaseDamage was tuned as a hit every ~60 Hz blast update; scaling by the step keeps that DPS at any simulation rate */
+	constexpr float BlastHitsPerSecond = 60.0f;
+}
+
 AAirblastSpell::AAirblastSpell()
 {
 	SpellName = "Airblast";
@@ -21,20 +30,18 @@ AAirblastSpell::AAirblastSpell()
 	ProjectileClass = AActor::StaticClass();
 }
 
-void AAirblastSpell::Execute(AWizardCharacter* Caster)
+bool AAirblastSpell::Execute(AWizardCharacter* Caster)
 {
-	Super::Execute(Caster);
-
-	if (!Caster)
+	if (!Super::Execute(Caster))
 	{
-		return;
+		return false;
 	}
 
 	FVector AimOrigin;
 	FVector AimDirection;
 	if (!Caster->GetAimData(AimOrigin, AimDirection))
 	{
-		return;
+		return false;
 	}
 
 	FVector SpawnLocation = AimOrigin + (AimDirection * 100.0f);
@@ -42,76 +49,84 @@ void AAirblastSpell::Execute(AWizardCharacter* Caster)
 	if (!ProjectileClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("AirblastSpell::Execute - No projectile class set"));
-		return;
+		return false;
 	}
 
-	// Spawn wide horizontal rectangle projectile (allows custom classes)
-	AActor* AirblastProjectile = GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnLocation, AimDirection.Rotation());
-	if (!AirblastProjectile)
+	UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>();
+	USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	if (!Timers || !Simulation)
 	{
-		return;
+		return false;
 	}
 
-	// Add a simple default mesh when using the bare AActor class
-	if (ProjectileClass == AActor::StaticClass())
-	{
-		UStaticMeshComponent* RectMesh = NewObject<UStaticMeshComponent>(AirblastProjectile);
-		RectMesh->RegisterComponent();
-		RectMesh->SetupAttachment(AirblastProjectile->GetRootComponent());
+	// The blast is just a point sweeping forward; only a custom projectile class gets a real actor
+	TSharedRef<FVector> BlastLocation = MakeShared<FVector>(SpawnLocation);
+	TWeakObjectPtr<AActor> WeakProjectile;
 
-		// Wide and short (horizontal rectangle)
-		FVector RectScale(1.0f, 4.0f, 3.0f); // Wide horizontally, shorter vertically
-		RectMesh->SetRelativeScale3D(RectScale);
+	if (ProjectileClass != AActor::StaticClass())
+	{
+		if (AActor* AirblastProjectile = GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnLocation, AimDirection.Rotation()))
+		{
+			Timers->SetActorLifeSpan(AirblastProjectile, ProjectileLifetime, EGameplayTimerCategory::AreaEffect);
+			WeakProjectile = AirblastProjectile;
+		}
+	}
+	else if (UCosmeticEffectSubsystem* Effects = GetWorld()->GetSubsystem<UCosmeticEffectSubsystem>())
+	{
+		// Wide horizontal rectangle travelling with the blast
+		FCosmeticEffectDesc Blast;
+		Blast.Type = ECosmeticEffectType::Airblast;
+		Blast.Location = SpawnLocation;
+		Blast.Direction = AimDirection;
+		Blast.Speed = ProjectileSpeed;
+		Blast.Duration = ProjectileLifetime;
+		Effects->PlayEffect(Blast);
 	}
-
-	// Set projectile to move forward and destroy after lifetime
-	AirblastProjectile->SetLifeSpan(ProjectileLifetime);
 
 	// Store initial data for tick-based movement
 	FVector Velocity = AimDirection * ProjectileSpeed;
-
-	// Lambda to handle movement and collision each tick
-	FTimerHandle TickTimer;
-	FTimerDelegate TickDelegate;
-
-	TWeakObjectPtr<AActor> WeakProjectile = AirblastProjectile;
 	TWeakObjectPtr<AWizardCharacter> WeakCaster = Caster;
 
-	TickDelegate.BindLambda([WeakProjectile, WeakCaster, Velocity, this]()
+	// Movement and collision every simulation step for the blast's lifetime, or until the spell goes away
+	Simulation->RunForDuration(ESimulationStepGroup::AreaEffects, this, ProjectileLifetime, [BlastLocation, WeakProjectile, WeakCaster, Velocity, this](float StepSeconds)
 	{
-		if (!WeakProjectile.IsValid() || !WeakCaster.IsValid())
+		if (!WeakCaster.IsValid())
 		{
 			return;
 		}
 
-		AActor* Projectile = WeakProjectile.Get();
 		AWizardCharacter* WizCaster = WeakCaster.Get();
 
-		// Move projectile forward
-		FVector NewLocation = Projectile->GetActorLocation() + (Velocity * 0.016f);
-		Projectile->SetActorLocation(NewLocation);
+		// Move the blast forward
+		*BlastLocation += Velocity * StepSeconds;
+		if (AActor* Projectile = WeakProjectile.Get())
+		{
+			Projectile->SetActorLocation(*BlastLocation);
+		}
 
 		// Check for zombies in range and knock them back
-		TArray<AActor*> FoundActors;
-		UGameplayStatics::GetAllActorsOfClass(Projectile->GetWorld(), AZombieCharacter::StaticClass(), FoundActors);
+		const UZombieSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>();
+		if (!Grid)
+		{
+			return;
+		}
+
+		FGameplayScratchScope Scratch;
+		TScratchArray<AZombieCharacter*> FoundZombies;
+		Grid->QueryRadius(*BlastLocation, BlastRadius, FoundZombies);
 
-		for (AActor* Actor : FoundActors)
+		for (AZombieCharacter* Zombie : FoundZombies)
 		{
-			AZombieCharacter* Zombie = Cast<AZombieCharacter>(Actor);
-			if (!Zombie)
-			{
-				continue;
-			}
 
-			float Distance = FVector::Dist(Projectile->GetActorLocation(), Zombie->GetActorLocation());
+			float Distance = FVector::Dist(*BlastLocation, Zombie->GetActorLocation());
 			if (Distance <= BlastRadius)
 			{
 				// Apply damage
 				FDamageEvent DamageEvent;
-				Zombie->TakeDamage(BaseDamage, DamageEvent, WizCaster->GetController(), Projectile);
+				Zombie->TakeDamage(BaseDamage * BlastHitsPerSecond * StepSeconds, DamageEvent, WizCaster->GetController(), this);
 
 				// Apply horizontal knockback only (no vertical lift)
-				FVector KnockbackDirection = (Zombie->GetActorLocation() - Projectile->GetActorLocation()).GetSafeNormal();
+				FVector KnockbackDirection = (Zombie->GetActorLocation() - *BlastLocation).GetSafeNormal();
 				KnockbackDirection.Z = 0.0f; // Remove vertical component for pure horizontal push
 				KnockbackDirection.Normalize();
 
@@ -121,8 +136,7 @@ void AAirblastSpell::Execute(AWizardCharacter* Caster)
 		}
 	});
 
-	GetWorld()->GetTimerManager().SetTimer(TickTimer, TickDelegate, 0.016f, true);
-
 	UE_LOG(LogTemp, Log, TEXT("Airblast projectile launched"));
+	return true;
 }
 
@@ -0,0 +1,226 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AttackSlotComponent.h"
+#include "Components/BoxComponent.h"
+
+UAttackSlotComponent::UAttackSlotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAttackSlotComponent::InitializeFromBox(UBoxComponent* Box)
+{
+	SlotBox = Box;
+	LocalSlotOffsets.Reset();
+	SlotOwners.Reset();
+	WaitQueue.Reset();
+
+	if (!Box)
+	{
+		return;
+	}
+
+	// Ring follows the box outline, pulled in slightly so a zombie standing on it still overlaps the box
+	const FVector Extent = Box->GetScaledBoxExtent();
+	const float HalfX = FMath::Max(Extent.X - SlotInset, 1.0f);
+	const float HalfY = FMath::Max(Extent.Y - SlotInset, 1.0f);
+	const float Perimeter = 4.0f * (HalfX + HalfY);
+
+	const int32 NumSlots = FMath::Clamp(FMath::RoundToInt(Perimeter / SlotSpacing), MinSlots, FMath::Max(MinSlots, MaxSlots));
+	const float Step = Perimeter / NumSlots;
+
+	for (int32 i = 0; i < NumSlots; i++)
+	{
+		// Walk the rectangle counter-clockwise starting at the +X edge
+		float Distance = (i + 0.5f) * Step;
+		FVector2D Offset;
+
+		if (Distance < 2.0f * HalfY)
+		{
+			Offset = FVector2D(HalfX, -HalfY + Distance);
+		}
+		else if ((Distance -= 2.0f * HalfY) < 2.0f * HalfX)
+		{
+			Offset = FVector2D(HalfX - Distance, HalfY);
+		}
+		else if ((Distance -= 2.0f * HalfX) < 2.0f * HalfY)
+		{
+			Offset = FVector2D(-HalfX, HalfY - Distance);
+		}
+		else
+		{
+			Distance -= 2.0f * HalfY;
+			Offset = FVector2D(-HalfX + Distance, -HalfY);
+		}
+
+		LocalSlotOffsets.Add(Offset);
+	}
+
+	SlotOwners.SetNum(NumSlots);
+}
+
+void UAttackSlotComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SlotOwners.Reset();
+	WaitQueue.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+int32 UAttackSlotComponent::ReserveSlot(AActor* Attacker)
+{
+	if (!Attacker || LocalSlotOffsets.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Already holding one
+	const int32 HeldSlot = FindSlotOwnedBy(Attacker);
+	if (HeldSlot != INDEX_NONE)
+	{
+		return HeldSlot;
+	}
+
+	PruneInvalidAttackers();
+
+	int32 FreeSlots = 0;
+	for (const TWeakObjectPtr<AActor>& Owner : SlotOwners)
+	{
+		if (!Owner.IsValid())
+		{
+			FreeSlots++;
+		}
+	}
+
+	// Respect arrival order: only the first FreeSlots queued attackers may take a slot
+	int32 QueuePosition = WaitQueue.IndexOfByKey(Attacker);
+	const int32 AheadInQueue = (QueuePosition == INDEX_NONE) ? WaitQueue.Num() : QueuePosition;
+
+	if (FreeSlots == 0 || AheadInQueue >= FreeSlots)
+	{
+		if (QueuePosition == INDEX_NONE)
+		{
+			WaitQueue.Add(Attacker);
+		}
+		return INDEX_NONE;
+	}
+
+	if (QueuePosition != INDEX_NONE)
+	{
+		WaitQueue.RemoveAt(QueuePosition);
+	}
+
+	// Take the free slot closest to the attacker so zombies don't cross the ring
+	const FVector AttackerLocation = Attacker->GetActorLocation();
+	int32 BestSlot = INDEX_NONE;
+	float BestDistanceSq = TNumericLimits<float>::Max();
+
+	for (int32 i = 0; i < SlotOwners.Num(); i++)
+	{
+		if (SlotOwners[i].IsValid())
+		{
+			continue;
+		}
+
+		const float DistanceSq = FVector::DistSquared2D(AttackerLocation, GetSlotLocation(i));
+		if (DistanceSq < BestDistanceSq)
+		{
+			BestDistanceSq = DistanceSq;
+			BestSlot = i;
+		}
+	}
+
+	if (BestSlot != INDEX_NONE)
+	{
+		SlotOwners[BestSlot] = Attacker;
+	}
+
+	return BestSlot;
+}
+
+void UAttackSlotComponent::ReleaseSlot(AActor* Attacker)
+{
+	const int32 HeldSlot = FindSlotOwnedBy(Attacker);
+	if (HeldSlot != INDEX_NONE)
+	{
+		SlotOwners[HeldSlot] = nullptr;
+	}
+
+	WaitQueue.Remove(Attacker);
+}
+
+FVector UAttackSlotComponent::GetSlotLocation(int32 SlotIndex) const
+{
+	const UBoxComponent* Box = SlotBox.Get();
+	if (!Box || !LocalSlotOffsets.IsValidIndex(SlotIndex))
+	{
+		return GetOwner() ? GetOwner()->GetActorLocation() : FVector::ZeroVector;
+	}
+
+	const FVector2D& Offset = LocalSlotOffsets[SlotIndex];
+	const FQuat Rotation = Box->GetComponentQuat();
+	FVector Location = Box->GetComponentLocation() + Rotation.RotateVector(FVector(Offset.X, Offset.Y, 0.0f));
+
+	// Keep slots at the structure's base so they project onto the navmesh
+	if (const AActor* Owner = GetOwner())
+	{
+		Location.Z = Owner->GetActorLocation().Z;
+	}
+
+	return Location;
+}
+
+FVector UAttackSlotComponent::GetQueueLocation(const AActor* Attacker) const
+{
+	const UBoxComponent* Box = SlotBox.Get();
+	const FVector Center = Box ? Box->GetComponentLocation() : (GetOwner() ? GetOwner()->GetActorLocation() : FVector::ZeroVector);
+
+	if (!Attacker)
+	{
+		return Center;
+	}
+
+	// Wait on the attacker's side of the structure, just outside the box
+	FVector Direction = Attacker->GetActorLocation() - Center;
+	Direction.Z = 0.0f;
+	Direction = Direction.GetSafeNormal();
+	if (Direction.IsNearlyZero())
+	{
+		Direction = FVector::ForwardVector;
+	}
+
+	const float Radius = Box ? Box->GetScaledBoxExtent().Size2D() : 0.0f;
+	FVector Location = Center + Direction * (Radius + QueueDistance);
+	Location.Z = Attacker->GetActorLocation().Z;
+
+	return Location;
+}
+
+int32 UAttackSlotComponent::FindSlotOwnedBy(const AActor* Attacker) const
+{
+	for (int32 i = 0; i < SlotOwners.Num(); i++)
+	{
+		if (SlotOwners[i].Get() == Attacker)
+		{
+			return i;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void UAttackSlotComponent::PruneInvalidAttackers()
+{
+	for (TWeakObjectPtr<AActor>& Owner : SlotOwners)
+	{
+		if (Owner.IsStale())
+		{
+			Owner = nullptr;
+		}
+	}
+
+	WaitQueue.RemoveAll([](const TWeakObjectPtr<AActor>& Attacker)
+	{
+		return !Attacker.IsValid();
+	});
+}
@@ -2,16 +2,18 @@
 
 #include "BuildModeTimerWidget.h"
 #include "WaveManager.h"
+#include "GameplayEventBus.h"
 #include "Components/TextBlock.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
+#include "Components/InvalidationBox.h"
 #include "EngineUtils.h"
 #include "Blueprint/WidgetTree.h"
 
 UBuildModeTimerWidget::UBuildModeTimerWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	// FORCE this widget to always tick
+	// Event driven - no NativeTick
 	bIsFocusable = false;
 	SetVisibility(ESlateVisibility::SelfHitTestInvisible);
 }
@@ -42,7 +44,11 @@ void UBuildModeTimerWidget::NativeConstruct()
 
 			if (UCanvasPanel* Canvas = Cast<UCanvasPanel>(RootWidget))
 			{
-				UCanvasPanelSlot* CanvasSlot = Canvas->AddChildToCanvas(TimerText);
+				// Cache the text's geometry so the canvas only repaints when the countdown changes
+				UInvalidationBox* InvalidationBox = NewObject<UInvalidationBox>(this);
+				InvalidationBox->SetContent(TimerText);
+
+				UCanvasPanelSlot* CanvasSlot = Canvas->AddChildToCanvas(InvalidationBox);
 				if (CanvasSlot)
 				{
 					// Center the text
@@ -69,21 +75,36 @@ void UBuildModeTimerWidget::NativeConstruct()
 		TimerText->SetText(FText::FromString(TEXT("BUILD MODE STARTING...")));
 	}
 
+	// React to the wave flow instead of polling it
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		BuildModeSecondHandle = EventBus->OnBuildModeSecondElapsed.AddUObject(this, &UBuildModeTimerWidget::OnBuildModeSecondElapsed);
+		WaveStartedHandle = EventBus->OnWaveStarted.AddUObject(this, &UBuildModeTimerWidget::OnWaveStarted);
+	}
+
+	// Pick up the current state in case we were created mid-break
+	if (WaveManager && WaveManager->IsInBuildMode())
+	{
+		OnBuildModeSecondElapsed(FMath::CeilToInt(WaveManager->GetBuildModeTimeRemaining()));
+	}
+	else if (WaveManager && WaveManager->IsWaveActive())
+	{
+		OnWaveStarted(WaveManager->GetCurrentWave());
+	}
+
 	// Set widget size
 	SetDesiredSizeInViewport(FVector2D(1920, 1080));
 }
 
 void UBuildModeTimerWidget::NativeDestruct()
 {
-	Super::NativeDestruct();
-}
-
-void UBuildModeTimerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
-{
-	Super::NativeTick(MyGeometry, InDeltaTime);
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnBuildModeSecondElapsed.Remove(BuildModeSecondHandle);
+		EventBus->OnWaveStarted.Remove(WaveStartedHandle);
+	}
 
-	// Update the timer every frame
-	UpdateTimer();
+	Super::NativeDestruct();
 }
 
 void UBuildModeTimerWidget::FindWaveManager()
@@ -95,46 +116,21 @@ void UBuildModeTimerWidget::FindWaveManager()
 	}
 }
 
-void UBuildModeTimerWidget::UpdateTimer()
+void UBuildModeTimerWidget::OnBuildModeSecondElapsed(int32 SecondsRemaining)
 {
-	if (!WaveManager)
-	{
-		// Try to find it if we don't have it yet
-		FindWaveManager();
-
-		if (!WaveManager)
-		{
-			return;
-		}
-	}
-
 	if (!TimerText)
 	{
 		return;
 	}
 
-	// ALWAYS keep widget visible, just change the text
-	SetVisibility(ESlateVisibility::SelfHitTestInvisible);
-
-	bool bInBuildMode = WaveManager->IsInBuildMode();
-
-	if (bInBuildMode)
-	{
-		// Get remaining time and format it
-		float RemainingTime = WaveManager->GetBuildModeTimeRemaining();
-		int32 SecondsRemaining = FMath::CeilToInt(RemainingTime);
-
-		// Create the text
-		FText TimerDisplayText = FText::FromString(FString::Printf(TEXT("BUILD MODE: %d"), SecondsRemaining));
-		TimerText->SetText(TimerDisplayText);
+	TimerText->SetText(FText::FromString(FString::Printf(TEXT("BUILD MODE: %d"), SecondsRemaining)));
+	TimerText->SetColorAndOpacity(FLinearColor(1.0f, 0.8f, 0.0f, 1.0f));
+}
 
-		// Force color - bright yellow
-		TimerText->SetColorAndOpacity(FLinearColor(1.0f, 0.8f, 0.0f, 1.0f));
-	}
-	else
+void UBuildModeTimerWidget::OnWaveStarted(int32 Wave)
+{
+	if (TimerText)
 	{
-		// Clear the text when not in build mode (but keep widget visible to keep ticking!)
 		TimerText->SetText(FText::GetEmpty());
 	}
 }
-
@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CosmeticEffectSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+
+DECLARE_STATS_GROUP(TEXT("Cosmetic Effects"), STATGROUP_CosmeticEffects, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Effects"), STAT_CosmeticEffects_Active, STATGROUP_CosmeticEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Components"), STAT_CosmeticEffects_Pooled, STATGROUP_CosmeticEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped This Frame"), STAT_CosmeticEffects_Dropped, STATGROUP_CosmeticEffects);
+
+namespace
+{
+	/** Scale of the default mesh per type; X runs along the effect's direction */
+	FVector GetDefaultScale(ECosmeticEffectType Type)
+	{
+		switch (Type)
+		{
+		case ECosmeticEffectType::LightningBolt:
+			// Long thin bar falling along its length
+			return FVector(3.0f, 0.1f, 0.1f);
+		case ECosmeticEffectType::Airblast:
+			// Wide horizontally, shorter vertically
+			return FVector(1.0f, 4.0f, 3.0f);
+		default:
+			return FVector::OneVector;
+		}
+	}
+}
+
+void FCosmeticEffectDesc::CopyAppearanceFrom(const AActor* Template)
+{
+	const UStaticMeshComponent* TemplateMesh = Template ? Template->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+	if (!TemplateMesh || !TemplateMesh->GetStaticMesh())
+	{
+		return;
+	}
+
+	Mesh = TemplateMesh->GetStaticMesh();
+	Material = TemplateMesh->GetMaterial(0);
+	Scale = TemplateMesh->GetRelativeScale3D();
+}
+
+bool UCosmeticEffectSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_SERVER
+	return false;
+#else
+	// Nothing to look at on a dedicated server or a -nullrhi run, so don't pay for the visuals
+	return !IsRunningDedicatedServer() && FApp::CanEverRender() && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+bool UCosmeticEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCosmeticEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	DefaultMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+}
+
+void UCosmeticEffectSubsystem::Deinitialize()
+{
+	ActiveEffects.Reset();
+	FreeComponents.Reset();
+	AllComponents.Reset();
+	EffectHost = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UCosmeticEffectSubsystem::PlayEffect(const FCosmeticEffectDesc& Desc)
+{
+#if UE_SERVER
+	return false;
+#else
+	UStaticMesh* Mesh = Desc.Mesh ? Desc.Mesh : DefaultMesh.Get();
+	if (!Mesh || Desc.Duration <= 0.0f)
+	{
+		return false;
+	}
+
+	if (ActiveEffects.Num() >= MaxActiveEffects)
+	{
+		INC_DWORD_STAT(STAT_CosmeticEffects_Dropped);
+		return false;
+	}
+
+	UStaticMeshComponent* Component = AcquireComponent();
+	if (!Component)
+	{
+		return false;
+	}
+
+	const FVector Direction = Desc.Direction.GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+
+	Component->SetStaticMesh(Mesh);
+	Component->SetMaterial(0, Desc.Material);
+	Component->SetWorldLocationAndRotation(Desc.Location, Desc.Rotation.Get(Direction.Rotation()));
+	Component->SetWorldScale3D(Desc.Scale.Get(GetDefaultScale(Desc.Type)));
+	Component->SetVisibility(true);
+
+	FActiveEffect& Effect = ActiveEffects.AddDefaulted_GetRef();
+	Effect.Component = Component;
+	Effect.Velocity = Direction * Desc.Speed;
+	Effect.RemainingTime = Desc.Duration;
+	return true;
+#endif
+}
+
+UStaticMeshComponent* UCosmeticEffectSubsystem::AcquireComponent()
+{
+	if (FreeComponents.Num() > 0)
+	{
+		return FreeComponents.Pop(EAllowShrinking::No);
+	}
+
+	if (!IsValid(EffectHost))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		EffectHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!EffectHost)
+		{
+			return nullptr;
+		}
+
+		USceneComponent* Root = NewObject<USceneComponent>(EffectHost, TEXT("Root"));
+		EffectHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	// Visual only: no collision, overlaps, navigation or shadows, and placed in world space
+	UStaticMeshComponent* Component = NewObject<UStaticMeshComponent>(EffectHost);
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetGenerateOverlapEvents(false);
+	Component->SetCanEverAffectNavigation(false);
+	Component->SetCastShadow(false);
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetUsingAbsoluteRotation(true);
+	Component->SetUsingAbsoluteScale(true);
+	Component->SetupAttachment(EffectHost->GetRootComponent());
+	Component->RegisterComponent();
+
+	AllComponents.Add(Component);
+	return Component;
+}
+
+void UCosmeticEffectSubsystem::ReleaseComponent(UStaticMeshComponent* Component)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	Component->SetVisibility(false);
+	FreeComponents.Add(Component);
+}
+
+void UCosmeticEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+#if !UE_SERVER
+	for (int32 i = ActiveEffects.Num() - 1; i >= 0; i--)
+	{
+		FActiveEffect& Effect = ActiveEffects[i];
+		Effect.RemainingTime -= DeltaTime;
+
+		if (Effect.RemainingTime <= 0.0f || !IsValid(Effect.Component))
+		{
+			ReleaseComponent(Effect.Component);
+			ActiveEffects.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (!Effect.Velocity.IsZero())
+		{
+			Effect.Component->SetWorldLocation(Effect.Component->GetComponentLocation() + Effect.Velocity * DeltaTime);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CosmeticEffects_Active, ActiveEffects.Num());
+	SET_DWORD_STAT(STAT_CosmeticEffects_Pooled, AllComponents.Num());
+#endif
+}
+
+TStatId UCosmeticEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCosmeticEffectSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CursorTraceComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+UCursorTraceComponent::UCursorTraceComponent()
+{
+	// Only ticks in async mode, to kick off the next trace
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UCursorTraceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bUseAsyncTrace)
+	{
+		AsyncTraceDelegate.BindUObject(this, &UCursorTraceComponent::OnAsyncTraceDone);
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UCursorTraceComponent::UpdateRay()
+{
+	if (Result.FrameNumber == GFrameCounter)
+	{
+		return;
+	}
+
+	Result.FrameNumber = GFrameCounter;
+
+	if (bHasRayOverride)
+	{
+		Result.RayOrigin = RayOverrideOrigin;
+		Result.RayDirection = RayOverrideDirection;
+		Result.bFromCursor = true;
+		return;
+	}
+
+	APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (!PC)
+	{
+		Result.bFromCursor = false;
+		return;
+	}
+
+	float MouseX = 0.0f;
+	float MouseY = 0.0f;
+	if (PC->GetMousePosition(MouseX, MouseY) && PC->DeprojectScreenPositionToWorld(MouseX, MouseY, Result.RayOrigin, Result.RayDirection))
+	{
+		Result.bFromCursor = true;
+		return;
+	}
+
+	// No cursor (captured or gamepad), fall back to the camera centre
+	FRotator CameraRotation;
+	PC->GetPlayerViewPoint(Result.RayOrigin, CameraRotation);
+	Result.RayDirection = CameraRotation.Vector();
+	Result.bFromCursor = false;
+}
+
+void UCursorTraceComponent::SetRayOverride(const FVector& Origin, const FVector& Direction)
+{
+	bHasRayOverride = true;
+	RayOverrideOrigin = Origin;
+	RayOverrideDirection = Direction.GetSafeNormal();
+
+	// Pick the new ray up this frame rather than next
+	Result.FrameNumber = 0;
+	TraceFrame = MAX_uint64;
+}
+
+FCollisionQueryParams UCursorTraceComponent::MakeQueryParams() const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CursorTrace), false);
+
+	if (const APlayerController* PC = Cast<APlayerController>(GetOwner()))
+	{
+		if (APawn* Pawn = PC->GetPawn())
+		{
+			QueryParams.AddIgnoredActor(Pawn);
+		}
+	}
+
+	return QueryParams;
+}
+
+void UCursorTraceComponent::UpdateTrace()
+{
+	if (TraceFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	TraceFrame = GFrameCounter;
+	UpdateRay();
+
+	FHitResult Hit;
+	const FVector TraceEnd = Result.RayOrigin + Result.RayDirection * TraceDistance;
+	Result.bValid = GetWorld()->LineTraceSingleByChannel(Hit, Result.RayOrigin, TraceEnd, TraceChannel, MakeQueryParams());
+	Result.ImpactPoint = Hit.ImpactPoint;
+	Result.HitActor = Hit.GetActor();
+}
+
+void UCursorTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateRay();
+
+	const FVector TraceEnd = Result.RayOrigin + Result.RayDirection * TraceDistance;
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Result.RayOrigin, TraceEnd, TraceChannel,
+		MakeQueryParams(), FCollisionResponseParams::DefaultResponseParam, &AsyncTraceDelegate);
+}
+
+void UCursorTraceComponent::OnAsyncTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	Result.bValid = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+	Result.ImpactPoint = Result.bValid ? FVector(Datum.OutHits[0].ImpactPoint) : FVector::ZeroVector;
+	Result.HitActor = Result.bValid ? Datum.OutHits[0].GetActor() : nullptr;
+}
+
+const FCursorTraceResult& UCursorTraceComponent::GetCursorHit()
+{
+	if (!bUseAsyncTrace)
+	{
+		UpdateTrace();
+	}
+
+	return Result;
+}
+
+bool UCursorTraceComponent::GetCursorRay(FVector& OutOrigin, FVector& OutDirection)
+{
+	UpdateRay();
+	OutOrigin = Result.RayOrigin;
+	OutDirection = Result.RayDirection;
+	return GetOwner() != nullptr;
+}
@@ -9,6 +9,7 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
 #include "Styling/CoreStyle.h"
+#include "LevelTransitionSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 UDeathScreenWidget::UDeathScreenWidget(const FObjectInitializer& ObjectInitializer)
@@ -77,6 +78,24 @@ TSharedRef<SWidget> UDeathScreenWidget::RebuildWidget()
 							.ColorAndOpacity(FSlateColor(FLinearColor::White))
 						]
 					]
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Center)
+					.Padding(FMargin(0.f, 14.f, 0.f, 0.f))
+					[
+						SNew(SButton)
+						.Visibility_Lambda([this]() { return OnRetryWave.IsBound() ? EVisibility::Visible : EVisibility::Collapsed; })
+						.OnClicked(FOnClicked::CreateUObject(this, &UDeathScreenWidget::HandleRetryWaveClicked))
+						.ContentPadding(FMargin(20.f, 8.f))
+						.ButtonColorAndOpacity(FSlateColor(FLinearColor(0.3f, 0.3f, 0.3f, 1.f)))
+						[
+							SNew(STextBlock)
+							.Text(NSLOCTEXT("DeathScreen", "RetryWave", "Retry this wave"))
+							.Font(BodyFont)
+							.Justification(ETextJustify::Center)
+							.ColorAndOpacity(FSlateColor(FLinearColor::White))
+						]
+					]
 				]
 			]
 		]
@@ -86,9 +105,23 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 FReply UDeathScreenWidget::HandleTryAgainClicked()
 {
-	if (UWorld* World = GetWorld())
+	if (OnTryAgain.IsBound())
+	{
+		OnTryAgain.Execute();
+	}
+	else if (ULevelTransitionSubsystem* LevelTransition = ULevelTransitionSubsystem::Get(this))
+	{
+		LevelTransition->TravelToLevel(TEXT("TitleScreen"));
+	}
+	else if (UWorld* World = GetWorld())
 	{
 		UGameplayStatics::OpenLevel(World, FName("TitleScreen"));
 	}
 	return FReply::Handled();
 }
+
+FReply UDeathScreenWidget::HandleRetryWaveClicked()
+{
+	OnRetryWave.ExecuteIfBound();
+	return FReply::Handled();
+}
@@ -14,15 +14,12 @@ AFireballSpell::AFireballSpell()
 	Cooldown = 0.5f;
 }
 
-void AFireballSpell::Execute(AWizardCharacter* Caster)
+bool AFireballSpell::Execute(AWizardCharacter* Caster)
 {
-	// Call parent to handle cooldown
-	Super::Execute(Caster);
-
-	if (!Caster || !ProjectileClass)
+	if (!Super::Execute(Caster) || !ProjectileClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FireballSpell::Execute - Missing caster or projectile class!"));
-		return;
+		return false;
 	}
 
 	FVector AimOrigin;
@@ -30,7 +27,7 @@ void AFireballSpell::Execute(AWizardCharacter* Caster)
 	if (!Caster->GetAimData(AimOrigin, AimDirection))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FireballSpell::Execute - No aim data available!"));
-		return;
+		return false;
 	}
 
 	// Spawn location slightly in front of camera
@@ -48,10 +45,13 @@ void AFireballSpell::Execute(AWizardCharacter* Caster)
 		SpawnParams
 	);
 
-	if (Projectile)
+	if (!Projectile)
 	{
-		Projectile->InitializeProjectile(AimDirection, BaseDamage);
-		UE_LOG(LogTemp, Log, TEXT("Fireball cast!"));
+		return false;
 	}
+
+	Projectile->InitializeProjectile(AimDirection, BaseDamage);
+	UE_LOG(LogTemp, Log, TEXT("Fireball cast!"));
+	return true;
 }
 
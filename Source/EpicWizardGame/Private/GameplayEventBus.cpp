@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayEventBus.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+UGameplayEventBus* UGameplayEventBus::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGameplayEventBus>() : nullptr;
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayRandomSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+
+UGameplayRandomSubsystem* UGameplayRandomSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGameplayRandomSubsystem>() : nullptr;
+}
+
+void UGameplayRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	int32 CommandLineSeed = 0;
+	SetRunSeed(FParse::Value(FCommandLine::Get(), TEXT("RandomSeed="), CommandLineSeed) ? CommandLineSeed : FMath::Rand());
+}
+
+void UGameplayRandomSubsystem::SetRunSeed(int32 NewRunSeed)
+{
+	RunSeed = NewRunSeed;
+
+	for (uint8 Stream = 0; Stream < static_cast<uint8>(EGameplayRandomStream::Count); Stream++)
+	{
+		Streams[Stream].Initialize(static_cast<int32>(HashCombine(static_cast<uint32>(RunSeed), Stream)));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("GameplayRandom: Run seed %d (-RandomSeed=%d to reproduce)"), RunSeed, RunSeed);
+}
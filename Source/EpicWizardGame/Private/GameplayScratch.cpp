@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayScratch.h"
+
+DECLARE_STATS_GROUP(TEXT("Gameplay Scratch"), STATGROUP_GameplayScratch, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scopes This Frame"), STAT_GameplayScratch_Scopes, STATGROUP_GameplayScratch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bytes This Frame"), STAT_GameplayScratch_Bytes, STATGROUP_GameplayScratch);
+
+FGameplayScratchScope::FGameplayScratchScope()
+	: Mark(FMemStack::Get())
+	, StartByteCount(FMemStack::Get().GetByteCount())
+{
+	check(IsInGameThread());
+	INC_DWORD_STAT(STAT_GameplayScratch_Scopes);
+}
+
+FGameplayScratchScope::~FGameplayScratchScope()
+{
+	INC_DWORD_STAT_BY(STAT_GameplayScratch_Bytes, FMath::Max(FMemStack::Get().GetByteCount() - StartByteCount, 0));
+	Mark.Pop();
+}
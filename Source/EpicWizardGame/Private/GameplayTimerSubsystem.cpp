@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayTimerSubsystem.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_STATS_GROUP(TEXT("Gameplay Timers"), STATGROUP_GameplayTimers, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Advance Wheel"), STAT_GameplayTimers_Advance, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fired This Frame"), STAT_GameplayTimers_Fired, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Total"), STAT_GameplayTimers_Total, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Zombie AI"), STAT_GameplayTimers_ZombieAI, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Zombie Animation"), STAT_GameplayTimers_ZombieAnimation, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Zombie Death"), STAT_GameplayTimers_ZombieDeath, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Status Effect"), STAT_GameplayTimers_StatusEffect, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Projectile Lifetime"), STAT_GameplayTimers_ProjectileLifetime, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Area Effect"), STAT_GameplayTimers_AreaEffect, STATGROUP_GameplayTimers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active: Other"), STAT_GameplayTimers_Other, STATGROUP_GameplayTimers);
+
+FGameplayTimerHandle UGameplayTimerSubsystem::SetTimer(EGameplayTimerCategory Category, float Delay, FSimpleDelegate Callback, bool bLoop)
+{
+	const uint64 DelayTicks = static_cast<uint64>(FMath::Max<int64>(FMath::CeilToInt64(Delay / TickInterval), 1));
+	return Wheel.Add(DelayTicks, bLoop ? static_cast<uint32>(DelayTicks) : 0, static_cast<uint8>(Category), MoveTemp(Callback));
+}
+
+void UGameplayTimerSubsystem::ClearTimer(FGameplayTimerHandle& Handle)
+{
+	Wheel.Remove(Handle);
+}
+
+float UGameplayTimerSubsystem::GetTimerRemaining(const FGameplayTimerHandle& Handle) const
+{
+	const int64 RemainingTicks = Wheel.GetRemainingTicks(Handle);
+	return RemainingTicks < 0 ? -1.0f : static_cast<float>(RemainingTicks * TickInterval);
+}
+
+void UGameplayTimerSubsystem::SetActorLifeSpan(AActor* Actor, float LifeSpan, EGameplayTimerCategory Category)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	SetTimer(Category, LifeSpan, FSimpleDelegate::CreateWeakLambda(Actor, [Actor]()
+	{
+		Actor->Destroy();
+	}));
+}
+
+void UGameplayTimerSubsystem::AdvanceSimulation(float StepSeconds)
+{
+	ElapsedTime += StepSeconds;
+
+	int32 NumFired = 0;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GameplayTimers_Advance);
+		NumFired = Wheel.Advance(static_cast<uint64>(ElapsedTime / TickInterval));
+	}
+
+	INC_DWORD_STAT_BY(STAT_GameplayTimers_Fired, NumFired);
+	SET_DWORD_STAT(STAT_GameplayTimers_Total, Wheel.GetTotalActiveCount());
+	SET_DWORD_STAT(STAT_GameplayTimers_ZombieAI, GetActiveTimerCount(EGameplayTimerCategory::ZombieAI));
+	SET_DWORD_STAT(STAT_GameplayTimers_ZombieAnimation, GetActiveTimerCount(EGameplayTimerCategory::ZombieAnimation));
+	SET_DWORD_STAT(STAT_GameplayTimers_ZombieDeath, GetActiveTimerCount(EGameplayTimerCategory::ZombieDeath));
+	SET_DWORD_STAT(STAT_GameplayTimers_StatusEffect, GetActiveTimerCount(EGameplayTimerCategory::StatusEffect));
+	SET_DWORD_STAT(STAT_GameplayTimers_ProjectileLifetime, GetActiveTimerCount(EGameplayTimerCategory::ProjectileLifetime));
+	SET_DWORD_STAT(STAT_GameplayTimers_AreaEffect, GetActiveTimerCount(EGameplayTimerCategory::AreaEffect));
+	SET_DWORD_STAT(STAT_GameplayTimers_Other, GetActiveTimerCount(EGameplayTimerCategory::Other));
+}
@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayTimerWheel.h"
+
+FGameplayTimerWheel::FGameplayTimerWheel()
+{
+	for (int32& Head : SlotHeads)
+	{
+		Head = INDEX_NONE;
+	}
+}
+
+FGameplayTimerHandle FGameplayTimerWheel::Add(uint64 DelayTicks, uint32 IntervalTicks, uint8 Category, FSimpleDelegate&& Callback)
+{
+	const int32 NodeIndex = FreeNodes.Num() > 0 ? FreeNodes.Pop(EAllowShrinking::No) : Nodes.AddDefaulted();
+
+	FNode& Node = Nodes[NodeIndex];
+	Node.Callback = MoveTemp(Callback);
+	Node.ExpireTick = CurrentTick + FMath::Clamp<uint64>(DelayTicks, 1, MaxDelayTicks);
+	Node.IntervalTicks = static_cast<uint32>(FMath::Min<uint64>(IntervalTicks, MaxDelayTicks));
+	Node.Category = Category;
+	Node.bActive = true;
+
+	if (!ActiveCounts.IsValidIndex(Category))
+	{
+		ActiveCounts.SetNumZeroed(Category + 1);
+	}
+	ActiveCounts[Category]++;
+	NumActive++;
+
+	Link(NodeIndex);
+
+	FGameplayTimerHandle Handle;
+	Handle.Index = NodeIndex;
+	Handle.Serial = Node.Serial;
+	return Handle;
+}
+
+void FGameplayTimerWheel::Remove(FGameplayTimerHandle& Handle)
+{
+	if (IsActive(Handle))
+	{
+		// Expired timers waiting for their callback in Advance are already unlinked
+		if (Nodes[Handle.Index].Slot != INDEX_NONE)
+		{
+			Unlink(Handle.Index);
+		}
+		Release(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+bool FGameplayTimerWheel::IsActive(const FGameplayTimerHandle& Handle) const
+{
+	return Nodes.IsValidIndex(Handle.Index) && Nodes[Handle.Index].bActive && Nodes[Handle.Index].Serial == Handle.Serial;
+}
+
+int64 FGameplayTimerWheel::GetRemainingTicks(const FGameplayTimerHandle& Handle) const
+{
+	return IsActive(Handle) ? static_cast<int64>(Nodes[Handle.Index].ExpireTick - CurrentTick) : -1;
+}
+
+void FGameplayTimerWheel::Link(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	const uint64 Delta = Node.ExpireTick > CurrentTick ? Node.ExpireTick - CurrentTick : 0;
+
+	int32 Slot;
+	if (Delta < Level0Slots)
+	{
+		Slot = static_cast<int32>(Node.ExpireTick & (Level0Slots - 1));
+	}
+	else
+	{
+		// Pick the lowest upper level whose range covers the delay
+		int32 Level = 1;
+		int32 Shift = Level0Bits;
+		while (Level < NumUpperLevels && Delta >= (uint64(1) << (Shift + LevelNBits)))
+		{
+			Level++;
+			Shift += LevelNBits;
+		}
+
+		Slot = Level0Slots + (Level - 1) * LevelNSlots + static_cast<int32>((Node.ExpireTick >> Shift) & (LevelNSlots - 1));
+	}
+
+	Node.Slot = Slot;
+	Node.Prev = INDEX_NONE;
+	Node.Next = SlotHeads[Slot];
+	if (Node.Next != INDEX_NONE)
+	{
+		Nodes[Node.Next].Prev = NodeIndex;
+	}
+	SlotHeads[Slot] = NodeIndex;
+}
+
+void FGameplayTimerWheel::Unlink(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+
+	if (Node.Prev != INDEX_NONE)
+	{
+		Nodes[Node.Prev].Next = Node.Next;
+	}
+	else
+	{
+		SlotHeads[Node.Slot] = Node.Next;
+	}
+
+	if (Node.Next != INDEX_NONE)
+	{
+		Nodes[Node.Next].Prev = Node.Prev;
+	}
+
+	Node.Prev = INDEX_NONE;
+	Node.Next = INDEX_NONE;
+	Node.Slot = INDEX_NONE;
+}
+
+void FGameplayTimerWheel::Release(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	Node.Callback.Unbind();
+	Node.bActive = false;
+	Node.Serial++;
+
+	ActiveCounts[Node.Category]--;
+	NumActive--;
+
+	FreeNodes.Add(NodeIndex);
+}
+
+void FGameplayTimerWheel::Cascade(int32 Slot)
+{
+	int32 NodeIndex = SlotHeads[Slot];
+	SlotHeads[Slot] = INDEX_NONE;
+
+	while (NodeIndex != INDEX_NONE)
+	{
+		const int32 Next = Nodes[NodeIndex].Next;
+		Link(NodeIndex);
+		NodeIndex = Next;
+	}
+}
+
+int32 FGameplayTimerWheel::Advance(uint64 TargetTick)
+{
+	ExpiredScratch.Reset();
+
+	while (CurrentTick < TargetTick)
+	{
+		// Nothing pending, no slots to walk
+		if (NumActive == 0)
+		{
+			CurrentTick = TargetTick;
+			break;
+		}
+
+		CurrentTick++;
+		const int32 Level0Index = static_cast<int32>(CurrentTick & (Level0Slots - 1));
+
+		// Level 0 wrapped: pull the next slot of each upper level down, stopping at the first level that didn't wrap
+		if (Level0Index == 0)
+		{
+			int32 Shift = Level0Bits;
+			for (int32 Level = 1; Level <= NumUpperLevels; Level++)
+			{
+				const int32 LevelIndex = static_cast<int32>((CurrentTick >> Shift) & (LevelNSlots - 1));
+				Cascade(Level0Slots + (Level - 1) * LevelNSlots + LevelIndex);
+				if (LevelIndex != 0)
+				{
+					break;
+				}
+				Shift += LevelNBits;
+			}
+		}
+
+		// Detach everything due this tick; callbacks run after the walk so they can add or clear timers freely
+		int32 NodeIndex = SlotHeads[Level0Index];
+		SlotHeads[Level0Index] = INDEX_NONE;
+		while (NodeIndex != INDEX_NONE)
+		{
+			FNode& Node = Nodes[NodeIndex];
+			const int32 Next = Node.Next;
+			Node.Prev = INDEX_NONE;
+			Node.Next = INDEX_NONE;
+			Node.Slot = INDEX_NONE;
+			ExpiredScratch.Emplace(NodeIndex, Node.Serial);
+			NodeIndex = Next;
+		}
+	}
+
+	int32 NumFired = 0;
+	for (int32 ExpiredIndex = 0; ExpiredIndex < ExpiredScratch.Num(); ExpiredIndex++)
+	{
+		const int32 NodeIndex = ExpiredScratch[ExpiredIndex].Key;
+		FNode& Node = Nodes[NodeIndex];
+
+		// Cleared by an earlier callback in this batch
+		if (!Node.bActive || Node.Serial != ExpiredScratch[ExpiredIndex].Value)
+		{
+			continue;
+		}
+
+		// Owner is gone, drop the timer instead of rescheduling it
+		if (!Node.Callback.IsBound())
+		{
+			Release(NodeIndex);
+			continue;
+		}
+
+		FSimpleDelegate Callback;
+		if (Node.IntervalTicks > 0)
+		{
+			Callback = Node.Callback;
+			Node.ExpireTick = FMath::Max(Node.ExpireTick + Node.IntervalTicks, CurrentTick + 1);
+			Link(NodeIndex);
+		}
+		else
+		{
+			Callback = MoveTemp(Node.Callback);
+			Release(NodeIndex);
+		}
+
+		// Node may be reallocated by the callback, don't touch it past here
+		Callback.Execute();
+		NumFired++;
+	}
+
+	ExpiredScratch.Reset();
+	return NumFired;
+}
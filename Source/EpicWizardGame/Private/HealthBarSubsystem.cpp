@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HealthBarSubsystem.h"
+
+int32 UHealthBarSubsystem::RegisterHealthBar(AActor* Owner, float VerticalOffset, const FVector2D& Size)
+{
+	FHealthBarEntry Entry;
+	Entry.Owner = Owner;
+	Entry.VerticalOffset = VerticalOffset;
+	Entry.Size = Size;
+
+	return Entries.Add(Entry);
+}
+
+void UHealthBarSubsystem::UnregisterHealthBar(int32& Handle)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries.RemoveAt(Handle);
+	}
+
+	Handle = INDEX_NONE;
+}
+
+void UHealthBarSubsystem::SetHealthPercent(int32 Handle, float HealthPercent)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].HealthPercent = FMath::Clamp(HealthPercent, 0.0f, 1.0f);
+	}
+}
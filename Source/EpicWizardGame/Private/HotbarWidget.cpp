@@ -4,10 +4,15 @@
 #include "Components/Border.h"
 #include "Components/Image.h"
 #include "SpellBase.h"
+#include "SpellbookComponent.h"
 #include "Turret.h"
 #include "WizardCharacter.h"
 #include "WizardPlayerController.h"
 #include "WaveManager.h"
+#include "TurretPlacementGrid.h"
+#include "TurretGhost.h"
+#include "CursorTraceComponent.h"
+#include "GameplayEventBus.h"
 #include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
@@ -19,52 +24,90 @@ void UHotbarWidget::NativeConstruct()
 	// Start with first slot selected
 	CurrentSlotIndex = 0;
 	CurrentMode = EHotbarMode::Spells;
-	PreviewTurret = nullptr;
+	PreviewGhost = nullptr;
 	UpdateVisuals();
 	UpdateSlotTextures();
+
+	// Track build mode from wave events instead of asking the wave manager every frame
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		WaveStartedHandle = EventBus->OnWaveStarted.AddUObject(this, &UHotbarWidget::OnWaveStarted);
+		WaveCompletedHandle = EventBus->OnWaveCompleted.AddUObject(this, &UHotbarWidget::OnWaveCompleted);
+	}
+
+	AWaveManager* WaveManager = GetWaveManager();
+	bBuildModeActive = WaveManager && WaveManager->IsInBuildMode();
 }
 
 void UHotbarWidget::NativeDestruct()
 {
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveStarted.Remove(WaveStartedHandle);
+		EventBus->OnWaveCompleted.Remove(WaveCompletedHandle);
+	}
+
 	DestroyPreviewTurret();
 	Super::NativeDestruct();
 }
 
-void UHotbarWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+AWaveManager* UHotbarWidget::GetWaveManager() const
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	// Update preview turret if in turret mode, not on slot 4, AND in build mode
-	if (CurrentMode == EHotbarMode::Turrets && CurrentSlotIndex != 4)
+	if (!bLookedUpWaveManager)
 	{
-		// Check if we're in build mode
-		AWaveManager* WaveManager = nullptr;
+		bLookedUpWaveManager = true;
 		for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
 		{
-			WaveManager = *It;
+			CachedWaveManager = *It;
 			break;
 		}
+	}
+
+	return CachedWaveManager.Get();
+}
 
-		if (WaveManager && WaveManager->IsInBuildMode())
+ATurretPlacementGrid* UHotbarWidget::GetPlacementGrid() const
+{
+	if (!bLookedUpPlacementGrid)
+	{
+		bLookedUpPlacementGrid = true;
+		CachedPlacementGrid = ATurretPlacementGrid::Find(this);
+	}
+
+	return CachedPlacementGrid.Get();
+}
+
+void UHotbarWidget::OnWaveStarted(int32 Wave)
+{
+	bBuildModeActive = false;
+}
+
+void UHotbarWidget::OnWaveCompleted(int32 Wave)
+{
+	bBuildModeActive = true;
+}
+
+void UHotbarWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	// Update preview turret if in turret mode, not on slot 4, AND in build mode
+	if (CurrentMode == EHotbarMode::Turrets && CurrentSlotIndex != 4)
+	{
+		if (bBuildModeActive)
 		{
 			UpdatePreviewTurret();
 		}
 		else
 		{
 			// Hide preview when not in build mode
-			if (PreviewTurret)
-			{
-				PreviewTurret->SetActorHiddenInGame(true);
-			}
+			HidePreviewTurret();
 		}
 	}
 	else
 	{
-		// Hide or destroy preview when not in turret placement mode
-		if (PreviewTurret)
-		{
-			PreviewTurret->SetActorHiddenInGame(true);
-		}
+		// Hide preview when not in turret placement mode
+		HidePreviewTurret();
 	}
 }
 
@@ -121,7 +164,7 @@ void UHotbarWidget::SelectSlotByNumber(int32 SlotNumber)
 	SelectSlot(SlotNumber - 1);
 }
 
-void UHotbarWidget::UseCurrentSlot()
+ESpellCastResult UHotbarWidget::UseCurrentSlot()
 {
 	OnSlotUsed.Broadcast(CurrentSlotIndex);
 	OnUseSlot(CurrentSlotIndex);
@@ -130,7 +173,7 @@ void UHotbarWidget::UseCurrentSlot()
 	if (CurrentSlotIndex == 4)
 	{
 		ToggleMode();
-		return;
+		return ESpellCastResult::NoSpell;
 	}
 
 	// Handle spell mode
@@ -141,64 +184,60 @@ void UHotbarWidget::UseCurrentSlot()
 		if (!SpellClass)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: No spell in slot %d"), CurrentSlotIndex + 1);
-			return;
+			return ESpellCastResult::NoSpell;
 		}
 
 		// Get the wizard character
 		AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetOwningPlayer());
 		if (!PC)
 		{
-			return;
+			return ESpellCastResult::NoSpell;
 		}
 
 		APawn* Pawn = PC->GetPawn();
 		AWizardCharacter* Wizard = Cast<AWizardCharacter>(Pawn);
 		if (!Wizard)
 		{
-			return;
+			return ESpellCastResult::NoSpell;
 		}
 
-		// Find or spawn the spell actor
-		ASpellBase* Spell = nullptr;
-		for (TActorIterator<ASpellBase> It(GetWorld(), SpellClass); It; ++It)
-		{
-			Spell = *It;
-			break;
-		}
+		USpellbookComponent* Spellbook = Wizard->GetSpellbook();
+		const ESpellCastResult Result = Spellbook->CastSlot(CurrentSlotIndex, SpellClass);
+		const ASpellBase* Spell = Spellbook->GetSpellInSlot(CurrentSlotIndex);
 
-		if (!Spell)
+		if (Result == ESpellCastResult::Cast && Spell)
 		{
-			// Spawn spell if it doesn't exist
-			Spell = GetWorld()->SpawnActor<ASpellBase>(SpellClass);
+			UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Cast %s from slot %d | Next shot in %.2fs"),
+				*Spell->SpellName, CurrentSlotIndex + 1, Spellbook->GetCooldownRemaining(CurrentSlotIndex));
 		}
-
-		if (Spell && Spell->CanCast())
+		else if (Result == ESpellCastResult::OnCooldown && Spell)
 		{
-			Spell->Execute(Wizard);
-			const float NextAvailable = Spell->GetCooldownRemaining();
-			UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Cast %s from slot %d | Next shot in %.2fs"), *Spell->SpellName, CurrentSlotIndex + 1, NextAvailable);
+			// Held input lands here every frame, keep it out of the default log
+			UE_LOG(LogTemp, Verbose, TEXT("HotbarWidget: %s on cooldown (%.1fs remaining)"),
+				*Spell->SpellName, Spellbook->GetCooldownRemaining(CurrentSlotIndex));
 		}
-		else if (Spell)
+		else if (Result == ESpellCastResult::Failed && Spell)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: %s on cooldown (%.1fs remaining)"), *Spell->SpellName, Spell->GetCooldownRemaining());
+			UE_LOG(LogTemp, Verbose, TEXT("HotbarWidget: %s found nothing to cast at, no cooldown used"), *Spell->SpellName);
 		}
+
+		return Result;
 	}
 	// Handle turret mode
 	else if (CurrentMode == EHotbarMode::Turrets)
 	{
-		FHitResult HitResult;
-		bool bHit = GetTurretPlacementHit(HitResult);
-
-		if (bHit)
+		FVector PlacementLocation;
+		if (GetTurretPlacementLocation(PlacementLocation))
 		{
-			PlaceTurret(CurrentSlotIndex, HitResult.Location);
-			UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Placed turret from slot %d at location %s"), CurrentSlotIndex, *HitResult.Location.ToString());
+			PlaceTurret(CurrentSlotIndex, PlacementLocation);
 		}
 		else
 		{
 			UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: No valid placement location found for turret"));
 		}
 	}
+
+	return ESpellCastResult::NoSpell;
 }
 
 void UHotbarWidget::UseSlot(int32 SlotIndex)
@@ -227,13 +266,10 @@ void UHotbarWidget::UseSlot(int32 SlotIndex)
 	// Handle turret mode (slots 0-3)
 	else if (CurrentMode == EHotbarMode::Turrets)
 	{
-		FHitResult HitResult;
-		bool bHit = GetTurretPlacementHit(HitResult);
-
-		if (bHit)
+		FVector PlacementLocation;
+		if (GetTurretPlacementLocation(PlacementLocation))
 		{
-			PlaceTurret(SlotIndex, HitResult.Location);
-			UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Placed turret from slot %d at location %s"), SlotIndex, *HitResult.Location.ToString());
+			PlaceTurret(SlotIndex, PlacementLocation);
 		}
 		else
 		{
@@ -325,10 +361,10 @@ void UHotbarWidget::SetMode(EHotbarMode NewMode)
 		UpdateSlotTextures();
 		OnModeChanged.Broadcast(CurrentMode);
 
-		// Destroy preview when switching to spell mode
+		// Hide preview when switching to spell mode; its meshes are kept for the next build phase
 		if (CurrentMode == EHotbarMode::Spells)
 		{
-			DestroyPreviewTurret();
+			HidePreviewTurret();
 		}
 
 		UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Switched to %s mode"),
@@ -352,14 +388,8 @@ void UHotbarWidget::PlaceTurret(int32 SlotIndex, const FVector& Location)
 		return;
 	}
 
-	// Find wave manager first (needed for multiple checks)
-	AWaveManager* WaveManager = nullptr;
-	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
-	{
-		WaveManager = *It;
-		break;
-	}
-
+	// Wave manager is needed for multiple checks
+	AWaveManager* WaveManager = GetWaveManager();
 	if (!WaveManager)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: No wave manager found!"));
@@ -373,6 +403,32 @@ void UHotbarWidget::PlaceTurret(int32 SlotIndex, const FVector& Location)
 		return;
 	}
 
+	// Snap to the placement grid and reject occupied or unbuildable cells
+	FVector SpawnLocation = Location;
+	if (ATurretPlacementGrid* Grid = GetPlacementGrid())
+	{
+		FIntPoint Cell;
+		if (!Grid->WorldToCell(Location, Cell) || !Grid->IsCellPlaceable(Cell))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: Cannot place turret there, cell is blocked or occupied"));
+			return;
+		}
+
+		// Don't let the player wall off a spawn gate from the tower
+		if (Grid->GetPathBlockingPolicy() != EPathBlockingPolicy::Allow && Grid->WouldBlockZombiePath(Cell))
+		{
+			if (Grid->GetPathBlockingPolicy() == EPathBlockingPolicy::Reject)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: Cannot place turret there, it would block the zombies' path to the tower"));
+				return;
+			}
+
+			UE_LOG(LogTemp, Warning, TEXT("HotbarWidget: Turret placed at %s blocks the zombies' path to the tower"), *Cell.ToString());
+		}
+
+		SpawnLocation = Grid->GetCellLocation(Cell);
+	}
+
 	int32 TurretCost = GetTurretCost(SlotIndex);
 	if (!WaveManager->SpendMoney(TurretCost))
 	{
@@ -384,12 +440,20 @@ void UHotbarWidget::PlaceTurret(int32 SlotIndex, const FVector& Location)
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
 	FRotator SpawnRotation = FRotator::ZeroRotator;
-	ATurret* Turret = GetWorld()->SpawnActor<ATurret>(TurretClass, Location, SpawnRotation, SpawnParams);
+	ATurret* Turret = GetWorld()->SpawnActor<ATurret>(TurretClass, SpawnLocation, SpawnRotation, SpawnParams);
 
 	if (Turret)
 	{
-		UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Spawned turret for $%d (Remaining: $%d)"),
-			TurretCost, WaveManager->GetPlayerMoney());
+		UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Spawned turret from slot %d at %s for $%d (Remaining: $%d)"),
+			SlotIndex, *SpawnLocation.ToString(), TurretCost, WaveManager->GetPlayerMoney());
+
+		// The grid marks the cell occupied from OnTurretPlaced; make the preview re-check it
+		LastPreviewCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			EventBus->OnTurretPlaced.Broadcast(Turret, TurretCost);
+		}
 	}
 }
 
@@ -448,169 +512,184 @@ UImage* UHotbarWidget::GetSlotImage(int32 SlotIndex) const
 	}
 }
 
-bool UHotbarWidget::GetTurretPlacementHit(FHitResult& OutHitResult) const
+bool UHotbarWidget::GetTurretPlacementRay(FVector& OutOrigin, FVector& OutDirection) const
 {
-	if (!GetWorld())
+	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetOwningPlayer());
+	if (!PC)
 	{
 		return false;
 	}
 
+	// Prefer the cursor ray (top-down / mouse-driven placement); it falls back to the camera centre itself
+	if (bUseCursorForTurretPlacement)
+	{
+		return PC->GetCursorTrace()->GetCursorRay(OutOrigin, OutDirection);
+	}
+
+	// Camera center ray (works even when cursor is hidden/captured)
+	FRotator CameraRotation;
+	PC->GetPlayerViewPoint(OutOrigin, CameraRotation);
+	OutDirection = CameraRotation.Vector();
+	return true;
+}
+
+bool UHotbarWidget::GetTurretPlacementHit(FHitResult& OutHitResult) const
+{
 	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetOwningPlayer());
-	if (!PC)
+	if (!PC || !GetWorld())
 	{
 		return false;
 	}
 
-	FCollisionQueryParams QueryParams;
-	if (APawn* Pawn = PC->GetPawn())
+	// Share the frame's cursor trace with aiming instead of tracing again
+	if (bUseCursorForTurretPlacement)
 	{
-		QueryParams.AddIgnoredActor(Pawn);
+		const FCursorTraceResult& CursorHit = PC->GetCursorTrace()->GetCursorHit();
+		if (!CursorHit.bValid)
+		{
+			return false;
+		}
+
+		OutHitResult = FHitResult(CursorHit.HitActor.Get(), nullptr, CursorHit.ImpactPoint, -CursorHit.RayDirection);
+		return true;
 	}
-	if (PreviewTurret)
+
+	FVector RayOrigin;
+	FVector RayDirection;
+	if (!GetTurretPlacementRay(RayOrigin, RayDirection))
 	{
-		QueryParams.AddIgnoredActor(PreviewTurret);
+		return false;
 	}
 
-	const float TraceDistance = TurretPlacementTraceDistance;
+	FCollisionQueryParams QueryParams;
+	if (APawn* Pawn = GetOwningPlayerPawn())
+	{
+		QueryParams.AddIgnoredActor(Pawn);
+	}
 
-	// Prefer cursor raycast (top-down / mouse-driven placement)
-	if (bUseCursorForTurretPlacement)
+	const FVector TraceEnd = RayOrigin + (RayDirection * TurretPlacementTraceDistance);
+	return GetWorld()->LineTraceSingleByChannel(OutHitResult, RayOrigin, TraceEnd, ECC_Visibility, QueryParams);
+}
+
+bool UHotbarWidget::GetTurretPlacementLocation(FVector& OutLocation) const
+{
+	// With a grid, the cursor ray only has to hit the grid plane, no scene trace needed
+	if (ATurretPlacementGrid* Grid = GetPlacementGrid())
 	{
-		float MouseX = 0.0f;
-		float MouseY = 0.0f;
-		if (PC->GetMousePosition(MouseX, MouseY))
+		FVector RayOrigin;
+		FVector RayDirection;
+		FIntPoint Cell;
+		if (GetTurretPlacementRay(RayOrigin, RayDirection) && Grid->RayToCell(RayOrigin, RayDirection, Cell))
 		{
-			FVector WorldOrigin;
-			FVector WorldDirection;
-			if (PC->DeprojectMousePositionToWorld(WorldOrigin, WorldDirection))
-			{
-				const FVector TraceEnd = WorldOrigin + (WorldDirection * TraceDistance);
-				if (GetWorld()->LineTraceSingleByChannel(OutHitResult, WorldOrigin, TraceEnd, ECC_Visibility, QueryParams))
-				{
-					return true;
-				}
-			}
+			OutLocation = Grid->GetCellLocation(Cell);
+			return true;
 		}
+
+		return false;
 	}
 
-	// Fallback: camera center raycast (works even when cursor is hidden/captured)
-	FVector CameraLocation;
-	FRotator CameraRotation;
-	PC->GetPlayerViewPoint(CameraLocation, CameraRotation);
+	FHitResult HitResult;
+	if (GetTurretPlacementHit(HitResult))
+	{
+		OutLocation = HitResult.Location;
+		return true;
+	}
 
-	const FVector TraceEnd = CameraLocation + (CameraRotation.Vector() * TraceDistance);
-	return GetWorld()->LineTraceSingleByChannel(OutHitResult, CameraLocation, TraceEnd, ECC_Visibility, QueryParams);
+	return false;
 }
 
 void UHotbarWidget::UpdatePreviewTurret()
 {
-	FHitResult HitResult;
-	bool bHit = GetTurretPlacementHit(HitResult);
+	TSubclassOf<ATurret> DesiredTurretClass = GetTurretInSlot(CurrentSlotIndex);
+	if (!DesiredTurretClass)
+	{
+		HidePreviewTurret();
+		return;
+	}
 
-	if (bHit)
+	// One ghost actor for the whole session
+	if (!PreviewGhost)
 	{
-		// Spawn preview turret if it doesn't exist or is wrong type
-		TSubclassOf<ATurret> DesiredTurretClass = GetTurretInSlot(CurrentSlotIndex);
-		if (DesiredTurretClass && (!PreviewTurret || PreviewTurret->GetClass() != DesiredTurretClass))
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		PreviewGhost = GetWorld()->SpawnActor<ATurretGhost>(ATurretGhost::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!PreviewGhost)
 		{
-			SpawnPreviewTurret();
+			return;
 		}
 
-		// Update preview turret position
-		if (PreviewTurret)
-		{
-			PreviewTurret->SetActorLocation(HitResult.Location);
-			PreviewTurret->SetActorHiddenInGame(false);
-		}
+		PreviewGhost->SetGhostMaterial(PreviewMaterial, PreviewOpacity);
 	}
-	else
+
+	// Switching turret type only swaps which pooled meshes are visible
+	if (PreviewGhost->GetTurretClass() != DesiredTurretClass)
+	{
+		PreviewGhost->ShowTurretClass(DesiredTurretClass);
+		LastPreviewCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	}
+
+	ATurretPlacementGrid* Grid = GetPlacementGrid();
+	if (!Grid)
 	{
-		// Hide preview if no valid placement
-		if (PreviewTurret)
+		// No grid in this level, follow the cursor trace freely
+		FHitResult HitResult;
+		if (GetTurretPlacementHit(HitResult))
 		{
-			PreviewTurret->SetActorHiddenInGame(true);
+			PreviewGhost->SetActorLocation(HitResult.Location);
+			PreviewGhost->SetGhostVisible(true);
 		}
+		else
+		{
+			PreviewGhost->SetGhostVisible(false);
+		}
+		return;
 	}
-}
 
-void UHotbarWidget::SpawnPreviewTurret()
-{
-	// Destroy existing preview
-	DestroyPreviewTurret();
-
-	TSubclassOf<ATurret> TurretClass = GetTurretInSlot(CurrentSlotIndex);
-	if (!TurretClass)
+	FVector RayOrigin;
+	FVector RayDirection;
+	FIntPoint Cell;
+	if (!GetTurretPlacementRay(RayOrigin, RayDirection) || !Grid->RayToCell(RayOrigin, RayDirection, Cell))
 	{
+		LastPreviewCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+		PreviewGhost->SetGhostVisible(false);
 		return;
 	}
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	FVector SpawnLocation = FVector::ZeroVector;
-	FRotator SpawnRotation = FRotator::ZeroRotator;
-
-	PreviewTurret = GetWorld()->SpawnActor<ATurret>(TurretClass, SpawnLocation, SpawnRotation, SpawnParams);
-
-	if (PreviewTurret)
+	// Nothing to do until the cursor moves into another cell
+	if (Cell == LastPreviewCell)
 	{
-		PreviewTurret->SetIsPreviewTurret(true);
-
-		// Disable collision and tick on preview
-		PreviewTurret->SetActorEnableCollision(false);
-		PreviewTurret->SetActorTickEnabled(false);
+		return;
+	}
 
-		// Make the preview translucent
-		TArray<UActorComponent*> Components;
-		PreviewTurret->GetComponents(UStaticMeshComponent::StaticClass(), Components);
+	LastPreviewCell = Cell;
 
-		for (UActorComponent* Component : Components)
-		{
-			UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component);
-			if (MeshComp)
-			{
-				// Apply preview material if set, otherwise just adjust opacity
-				if (PreviewMaterial)
-				{
-					for (int32 i = 0; i < MeshComp->GetNumMaterials(); i++)
-					{
-						MeshComp->SetMaterial(i, PreviewMaterial);
-					}
-				}
-				else
-				{
-					// Create a dynamic material instance with transparency
-					for (int32 i = 0; i < MeshComp->GetNumMaterials(); i++)
-					{
-						UMaterialInterface* OriginalMat = MeshComp->GetMaterial(i);
-						if (OriginalMat)
-						{
-							UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(OriginalMat, this);
-							if (DynMat)
-							{
-								DynMat->SetScalarParameterValue(FName("Opacity"), PreviewOpacity);
-								MeshComp->SetMaterial(i, DynMat);
-							}
-						}
-					}
-				}
-
-				// Enable transparency rendering
-				MeshComp->SetRenderCustomDepth(false);
-			}
-		}
+	const bool bBlocksPath = Grid->GetPathBlockingPolicy() == EPathBlockingPolicy::Reject && Grid->WouldBlockZombiePath(Cell);
+	if (Grid->IsCellPlaceable(Cell) && !bBlocksPath)
+	{
+		PreviewGhost->SetActorLocation(Grid->GetCellLocation(Cell));
+		PreviewGhost->SetGhostVisible(true);
+	}
+	else
+	{
+		PreviewGhost->SetGhostVisible(false);
+	}
+}
 
-		PreviewTurret->SetActorHiddenInGame(true);
-		UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Spawned preview turret"));
+void UHotbarWidget::HidePreviewTurret()
+{
+	if (PreviewGhost)
+	{
+		PreviewGhost->SetGhostVisible(false);
 	}
+	LastPreviewCell = FIntPoint(INDEX_NONE, INDEX_NONE);
 }
 
 void UHotbarWidget::DestroyPreviewTurret()
 {
-	if (PreviewTurret)
+	if (PreviewGhost)
 	{
-		PreviewTurret->Destroy();
-		PreviewTurret = nullptr;
+		PreviewGhost->Destroy();
+		PreviewGhost = nullptr;
 		UE_LOG(LogTemp, Log, TEXT("HotbarWidget: Destroyed preview turret"));
 	}
 }
@@ -635,14 +714,7 @@ int32 UHotbarWidget::GetTurretCost(int32 SlotIndex) const
 
 bool UHotbarWidget::CanAffordTurret(int32 SlotIndex) const
 {
-	// Find wave manager
-	AWaveManager* WaveManager = nullptr;
-	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
-	{
-		WaveManager = *It;
-		break;
-	}
-
+	AWaveManager* WaveManager = GetWaveManager();
 	if (!WaveManager)
 	{
 		return false;
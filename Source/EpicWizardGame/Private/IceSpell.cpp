@@ -12,14 +12,12 @@ AIceSpell::AIceSpell()
 	Cooldown = 1.0f;
 }
 
-void AIceSpell::Execute(AWizardCharacter* Caster)
+bool AIceSpell::Execute(AWizardCharacter* Caster)
 {
-	Super::Execute(Caster);
-
-	if (!Caster || !ProjectileClass)
+	if (!Super::Execute(Caster) || !ProjectileClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("IceSpell::Execute - Missing caster or projectile class!"));
-		return;
+		return false;
 	}
 
 	FVector AimOrigin;
@@ -27,7 +25,7 @@ void AIceSpell::Execute(AWizardCharacter* Caster)
 	if (!Caster->GetAimData(AimOrigin, AimDirection))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("IceSpell::Execute - No aim data available!"));
-		return;
+		return false;
 	}
 
 	FVector SpawnLocation = AimOrigin + (AimDirection * SpawnDistance);
@@ -36,19 +34,24 @@ void AIceSpell::Execute(AWizardCharacter* Caster)
 	SpawnParams.Owner = Caster;
 	SpawnParams.Instigator = Caster;
 
-	if (ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(
+	ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(
 		ProjectileClass,
 		SpawnLocation,
 		AimDirection.Rotation(),
-		SpawnParams))
+		SpawnParams);
+
+	if (!Projectile)
 	{
-		// Configure freeze effect on the projectile so hits slow enemies
-		Projectile->bApplyFreeze = true;
-		Projectile->FreezeDuration = FreezeDuration;
-		Projectile->FreezeSpeedMultiplier = FreezeSpeedMultiplier;
-		Projectile->bPierceTargets = false; // fireball-style: stop on first enemy
-
-		Projectile->InitializeProjectile(AimDirection, BaseDamage);
-		UE_LOG(LogTemp, Log, TEXT("Ice shard fired"));
+		return false;
 	}
+
+	// Configure freeze effect on the projectile so hits slow enemies
+	Projectile->bApplyFreeze = true;
+	Projectile->FreezeDuration = FreezeDuration;
+	Projectile->FreezeSpeedMultiplier = FreezeSpeedMultiplier;
+	Projectile->bPierceTargets = false; // fireball-style: stop on first enemy
+
+	Projectile->InitializeProjectile(AimDirection, BaseDamage);
+	UE_LOG(LogTemp, Log, TEXT("Ice shard fired"));
+	return true;
 }
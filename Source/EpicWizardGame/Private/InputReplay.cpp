@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InputReplay.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	/** "WRPL" */
+	constexpr uint32 InputReplayMagic = 0x4C505257;
+
+	int8 QuantizeAxis(double Value)
+	{
+		return static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(Value, -1.0, 1.0) * 127.0));
+	}
+
+	double DequantizeAxis(int8 Value)
+	{
+		return Value / 127.0;
+	}
+
+	void SerializeFrame(FArchive& Ar, FInputReplayFrame& Frame, uint32& PreviousStep)
+	{
+		uint32 StepDelta = Frame.Step - PreviousStep;
+		Ar.SerializeIntPacked(StepDelta);
+		Frame.Step = PreviousStep + StepDelta;
+		PreviousStep = Frame.Step;
+
+		uint8 Flags = static_cast<uint8>(Frame.Flags);
+		Ar << Flags;
+		Frame.Flags = static_cast<EInputReplayFlags>(Flags);
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::Move))
+		{
+			int8 X = QuantizeAxis(Frame.Move.X);
+			int8 Y = QuantizeAxis(Frame.Move.Y);
+			Ar << X << Y;
+			Frame.Move = FVector2D(DequantizeAxis(X), DequantizeAxis(Y));
+		}
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::ControlRotation))
+		{
+			uint16 Pitch = FRotator::CompressAxisToShort(Frame.ControlRotation.Pitch);
+			uint16 Yaw = FRotator::CompressAxisToShort(Frame.ControlRotation.Yaw);
+			Ar << Pitch << Yaw;
+			Frame.ControlRotation = FRotator(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0f);
+		}
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::CursorRay))
+		{
+			FVector3f Origin(Frame.CursorOrigin);
+			FVector3f Direction(Frame.CursorDirection);
+			Ar << Origin << Direction;
+			Frame.CursorOrigin = FVector(Origin);
+			Frame.CursorDirection = FVector(Direction);
+		}
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::HotbarSlot))
+		{
+			uint8 Slot = static_cast<uint8>(Frame.HotbarSlot);
+			Ar << Slot;
+			Frame.HotbarSlot = Slot;
+		}
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::HotbarScroll))
+		{
+			int8 Direction = static_cast<int8>(FMath::Sign(Frame.HotbarScroll));
+			Ar << Direction;
+			Frame.HotbarScroll = Direction;
+		}
+	}
+}
+
+void FInputReplay::Serialize(FArchive& Ar)
+{
+	Ar << MapName << RunSeed << StepRate;
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		// A frame is at least two bytes; don't trust a count the data can't back
+		if (NumFrames < 0 || NumFrames > Ar.TotalSize() / 2)
+		{
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNum(NumFrames);
+	}
+
+	uint32 PreviousStep = 0;
+	for (FInputReplayFrame& Frame : Frames)
+	{
+		SerializeFrame(Ar, Frame, PreviousStep);
+	}
+}
+
+bool FInputReplay::SaveToFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = InputReplayMagic;
+	int32 Version = CurrentVersion;
+	Writer << Magic << Version;
+	Serialize(Writer);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FInputReplay::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != InputReplayMagic || Version != CurrentVersion)
+	{
+		return false;
+	}
+
+	Serialize(Reader);
+	return !Reader.IsError();
+}
@@ -0,0 +1,438 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InputReplaySubsystem.h"
+#include "WizardCharacter.h"
+#include "WizardPlayerController.h"
+#include "CursorTraceComponent.h"
+#include "GameplayEventBus.h"
+#include "GameplayRandomSubsystem.h"
+#include "SimulationStepSubsystem.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+void UInputReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The seed and step rate are set from the replay before anything draws from them
+	Collection.InitializeDependency<UGameplayRandomSubsystem>();
+	Collection.InitializeDependency<USimulationStepSubsystem>();
+	Collection.InitializeDependency<UGameplayEventBus>();
+}
+
+bool UInputReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInputReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FString CurrentLevelName = InWorld.GetMapName();
+	CurrentLevelName.RemoveFromStart(InWorld.StreamingLevelsPrefix);
+	if (CurrentLevelName.Contains(TEXT("TitleScreen")) || CurrentLevelName.Contains(TEXT("DeathScreen")))
+	{
+		return;
+	}
+
+	FString ReplayName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("PlayReplay="), ReplayName))
+	{
+		bExitAfterReplay = FParse::Param(FCommandLine::Get(), TEXT("ExitAfterReplay"));
+		StartPlayback(ResolveReplayPath(ReplayName), CurrentLevelName);
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("RecordReplay="), ReplayName))
+	{
+		StartRecording(ResolveReplayPath(ReplayName), CurrentLevelName);
+	}
+
+	if (bRecording || bPlaying)
+	{
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			WaveStartedHandle = EventBus->OnWaveStarted.AddUObject(this, &UInputReplaySubsystem::OnWaveStarted);
+			ZombieDiedHandle = EventBus->OnZombieDied.AddUObject(this, &UInputReplaySubsystem::OnZombieDied);
+		}
+	}
+}
+
+void UInputReplaySubsystem::Deinitialize()
+{
+	if (bRecording)
+	{
+		FinishRecording();
+	}
+
+	// Leaving the map mid-replay must not leave the next one on our frame time
+	RestoreFixedTimeStep();
+
+	if (UEnhancedInputComponent* InputComponent = BoundInputComponent.Get())
+	{
+		for (const uint32 Handle : InputBindingHandles)
+		{
+			InputComponent->RemoveBindingByHandle(Handle);
+		}
+	}
+	InputBindingHandles.Reset();
+
+	if (USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>())
+	{
+		Simulation->OnStep(ESimulationStepGroup::Other).Remove(StepHandle);
+	}
+
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveStarted.Remove(WaveStartedHandle);
+		EventBus->OnZombieDied.Remove(ZombieDiedHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+FString UInputReplaySubsystem::GetReplayDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputReplays"));
+}
+
+FString UInputReplaySubsystem::ResolveReplayPath(const FString& Name)
+{
+	FString FilePath = FPaths::IsRelative(Name) ? FPaths::Combine(GetReplayDir(), Name) : Name;
+	if (FPaths::GetExtension(FilePath).IsEmpty())
+	{
+		FilePath += TEXT(".wrpl");
+	}
+	return FilePath;
+}
+
+void UInputReplaySubsystem::StartRecording(const FString& FilePath, const FString& MapName)
+{
+	USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	UGameplayRandomSubsystem* Random = GetWorld()->GetSubsystem<UGameplayRandomSubsystem>();
+	if (!Simulation || !Random)
+	{
+		return;
+	}
+
+	ReplayPath = FilePath;
+	Replay.MapName = MapName;
+	Replay.RunSeed = Random->GetRunSeed();
+	Replay.StepRate = Simulation->GetTargetStepRate();
+	bRecording = true;
+
+	// Playback steps at the recorded rate throughout; a rate dropped under load here would put input at other simulated times
+	Simulation->SetStepRateLocked(true);
+
+	StepHandle = Simulation->OnStep(ESimulationStepGroup::Other).AddUObject(this, &UInputReplaySubsystem::RecordStep);
+
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Recording to %s (seed %d, %.1f Hz)"), *ReplayPath, Replay.RunSeed, Replay.StepRate);
+}
+
+void UInputReplaySubsystem::FinishRecording()
+{
+	bRecording = false;
+
+	if (USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>())
+	{
+		Simulation->SetStepRateLocked(false);
+	}
+
+	if (!Replay.SaveToFile(ReplayPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InputReplay: Failed to write %s"), *ReplayPath);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Wrote %d input frames to %s"), Replay.Frames.Num(), *ReplayPath);
+}
+
+void UInputReplaySubsystem::StartPlayback(const FString& FilePath, const FString& MapName)
+{
+	USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	UGameplayRandomSubsystem* Random = GetWorld()->GetSubsystem<UGameplayRandomSubsystem>();
+	if (!Simulation || !Random)
+	{
+		return;
+	}
+
+	if (!Replay.LoadFromFile(FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("InputReplay: %s is missing or not a valid replay"), *FilePath);
+		return;
+	}
+
+	if (Replay.MapName != MapName)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InputReplay: %s was recorded on %s but this is %s"), *FilePath, *Replay.MapName, *MapName);
+	}
+
+	ReplayPath = FilePath;
+	bPlaying = true;
+
+	Random->SetRunSeed(Replay.RunSeed);
+	Simulation->SetStepRate(Replay.StepRate);
+
+	// One simulation step per frame, independent of how fast this machine runs it
+	if (!bOverrodeFixedTimeStep)
+	{
+		bPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+		PrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+		bOverrodeFixedTimeStep = true;
+	}
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / Simulation->GetStepRate());
+
+	TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UInputReplaySubsystem::OnWorldTickStart);
+
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Playing %d input frames from %s (seed %d, %.1f Hz)"),
+		Replay.Frames.Num(), *ReplayPath, Replay.RunSeed, Replay.StepRate);
+}
+
+void UInputReplaySubsystem::FinishPlayback()
+{
+	bPlaying = false;
+	FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+	RestoreFixedTimeStep();
+
+	const uint32 StepCount = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetStepCount();
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Playback finished on step %u with %d kills"), StepCount, ZombiesKilled);
+
+	if (bExitAfterReplay)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("InputReplay"));
+	}
+}
+
+void UInputReplaySubsystem::RestoreFixedTimeStep()
+{
+	if (!bOverrodeFixedTimeStep)
+	{
+		return;
+	}
+
+	FApp::SetUseFixedTimeStep(bPrevUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PrevFixedDeltaTime);
+	bOverrodeFixedTimeStep = false;
+}
+
+AWizardCharacter* UInputReplaySubsystem::BindWizard()
+{
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	AWizardCharacter* Wizard = PC ? Cast<AWizardCharacter>(PC->GetPawn()) : nullptr;
+	if (!bRecording || Wizard == BoundWizard.Get())
+	{
+		return Wizard;
+	}
+
+	if (UEnhancedInputComponent* OldInputComponent = BoundInputComponent.Get())
+	{
+		for (const uint32 Handle : InputBindingHandles)
+		{
+			OldInputComponent->RemoveBindingByHandle(Handle);
+		}
+	}
+	InputBindingHandles.Reset();
+	BoundWizard = nullptr;
+	BoundInputComponent = nullptr;
+
+	// Not possessed yet (no input component); try again next step
+	UEnhancedInputComponent* InputComponent = Wizard ? Cast<UEnhancedInputComponent>(Wizard->InputComponent) : nullptr;
+	if (!InputComponent)
+	{
+		return Wizard;
+	}
+
+	BoundWizard = Wizard;
+	BoundInputComponent = InputComponent;
+
+	// Listen alongside the wizard's own bindings; they still do the actual work
+	auto Bind = [this, InputComponent](const UInputAction* Action, ETriggerEvent TriggerEvent, TFunction<void(const FInputActionValue&)> Handler)
+	{
+		if (Action)
+		{
+			InputBindingHandles.Add(InputComponent->BindActionValueLambda(Action, TriggerEvent, MoveTemp(Handler)).GetHandle());
+		}
+	};
+
+	Bind(Wizard->MoveAction, ETriggerEvent::Triggered, [this](const FInputActionValue& Value) { HeldMove = Value.Get<FVector2D>(); });
+	Bind(Wizard->MoveAction, ETriggerEvent::Completed, [this](const FInputActionValue&) { HeldMove = FVector2D::ZeroVector; });
+	Bind(Wizard->CastSpellAction, ETriggerEvent::Triggered, [this](const FInputActionValue&) { bCastHeld = true; });
+	Bind(Wizard->CastSpellAction, ETriggerEvent::Completed, [this](const FInputActionValue&) { bCastHeld = false; });
+	Bind(Wizard->HotbarScrollAction, ETriggerEvent::Triggered, [this](const FInputActionValue& Value) { PendingHotbarScroll = Value.Get<float>(); });
+
+	const UInputAction* SlotActions[] = { Wizard->HotbarSlot1Action, Wizard->HotbarSlot2Action, Wizard->HotbarSlot3Action, Wizard->HotbarSlot4Action, Wizard->HotbarSlot5Action };
+	for (int32 SlotIndex = 0; SlotIndex < static_cast<int32>(UE_ARRAY_COUNT(SlotActions)); SlotIndex++)
+	{
+		Bind(SlotActions[SlotIndex], ETriggerEvent::Started, [this, SlotIndex](const FInputActionValue&) { PendingHotbarSlot = SlotIndex + 1; });
+	}
+
+	return Wizard;
+}
+
+void UInputReplaySubsystem::RecordStep(float StepSeconds)
+{
+	AWizardCharacter* Wizard = BindWizard();
+	AWizardPlayerController* PC = Wizard ? Cast<AWizardPlayerController>(Wizard->GetController()) : nullptr;
+
+	FInputReplayFrame Frame;
+	Frame.Step = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetStepCount();
+
+	if (HeldMove != LastRecorded.Move)
+	{
+		Frame.Flags |= EInputReplayFlags::Move;
+		Frame.Move = LastRecorded.Move = HeldMove;
+	}
+
+	if (PC)
+	{
+		const FRotator ControlRotation = PC->GetControlRotation();
+		if (!ControlRotation.Equals(LastRecorded.ControlRotation, 0.01f))
+		{
+			Frame.Flags |= EInputReplayFlags::ControlRotation;
+			Frame.ControlRotation = LastRecorded.ControlRotation = ControlRotation;
+		}
+
+		FVector RayOrigin;
+		FVector RayDirection;
+		if (PC->GetCursorTrace() && PC->GetCursorTrace()->GetCursorRay(RayOrigin, RayDirection)
+			&& (!RayOrigin.Equals(LastRecorded.CursorOrigin, 0.1f) || !RayDirection.Equals(LastRecorded.CursorDirection, 0.0001f)))
+		{
+			Frame.Flags |= EInputReplayFlags::CursorRay;
+			Frame.CursorOrigin = LastRecorded.CursorOrigin = RayOrigin;
+			Frame.CursorDirection = LastRecorded.CursorDirection = RayDirection;
+		}
+	}
+
+	if (PendingHotbarSlot > 0)
+	{
+		Frame.Flags |= EInputReplayFlags::HotbarSlot;
+		Frame.HotbarSlot = PendingHotbarSlot;
+		PendingHotbarSlot = 0;
+	}
+
+	if (PendingHotbarScroll != 0.0f)
+	{
+		Frame.Flags |= EInputReplayFlags::HotbarScroll;
+		Frame.HotbarScroll = PendingHotbarScroll;
+		PendingHotbarScroll = 0.0f;
+	}
+
+	// The cast flag is a state carried by every frame, so a frame is also needed whenever it flips
+	const bool bLastCastHeld = EnumHasAnyFlags(LastRecorded.Flags, EInputReplayFlags::CastHeld);
+	if (bCastHeld)
+	{
+		Frame.Flags |= EInputReplayFlags::CastHeld;
+	}
+
+	if (Frame.Flags != EInputReplayFlags::None || bCastHeld != bLastCastHeld)
+	{
+		Replay.Frames.Add(Frame);
+		LastRecorded.Flags = Frame.Flags;
+	}
+}
+
+void UInputReplaySubsystem::OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TickedWorld != GetWorld() || !bPlaying)
+	{
+		return;
+	}
+
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	AWizardCharacter* Wizard = PC ? Cast<AWizardCharacter>(PC->GetPawn()) : nullptr;
+
+	// Input recorded against a step is processed on the frame that runs it
+	const uint32 NextStep = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetStepCount() + 1;
+	while (Replay.Frames.IsValidIndex(PlaybackIndex) && Replay.Frames[PlaybackIndex].Step <= NextStep)
+	{
+		ApplyFrame(Replay.Frames[PlaybackIndex], Wizard);
+		PlaybackIndex++;
+	}
+
+	// Held input has to be injected every frame, like a real key that's still down
+	UEnhancedInputLocalPlayerSubsystem* Input = PC ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()) : nullptr;
+	if (Wizard && Input)
+	{
+		if (!HeldMove.IsZero() && Wizard->MoveAction)
+		{
+			Input->InjectInputForAction(Wizard->MoveAction, FInputActionValue(HeldMove));
+		}
+
+		if (bCastHeld && Wizard->CastSpellAction)
+		{
+			Input->InjectInputForAction(Wizard->CastSpellAction, FInputActionValue(true));
+		}
+	}
+
+	if (PlaybackIndex >= Replay.Frames.Num())
+	{
+		FinishPlayback();
+	}
+}
+
+void UInputReplaySubsystem::ApplyFrame(const FInputReplayFrame& Frame, AWizardCharacter* Wizard)
+{
+	if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::Move))
+	{
+		HeldMove = Frame.Move;
+	}
+
+	bCastHeld = EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::CastHeld);
+
+	AWizardPlayerController* PC = Wizard ? Cast<AWizardPlayerController>(Wizard->GetController()) : nullptr;
+	if (!PC)
+	{
+		return;
+	}
+
+	if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::ControlRotation))
+	{
+		PC->SetControlRotation(Frame.ControlRotation);
+	}
+
+	if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::CursorRay) && PC->GetCursorTrace())
+	{
+		PC->GetCursorTrace()->SetRayOverride(Frame.CursorOrigin, Frame.CursorDirection);
+	}
+
+	UEnhancedInputLocalPlayerSubsystem* Input = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer());
+	if (!Input)
+	{
+		return;
+	}
+
+	if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::HotbarSlot))
+	{
+		const UInputAction* SlotActions[] = { Wizard->HotbarSlot1Action, Wizard->HotbarSlot2Action, Wizard->HotbarSlot3Action, Wizard->HotbarSlot4Action, Wizard->HotbarSlot5Action };
+		const int32 SlotIndex = Frame.HotbarSlot - 1;
+		if (SlotIndex >= 0 && SlotIndex < static_cast<int32>(UE_ARRAY_COUNT(SlotActions)) && SlotActions[SlotIndex])
+		{
+			Input->InjectInputForAction(SlotActions[SlotIndex], FInputActionValue(true));
+		}
+	}
+
+	if (EnumHasAnyFlags(Frame.Flags, EInputReplayFlags::HotbarScroll) && Wizard->HotbarScrollAction)
+	{
+		Input->InjectInputForAction(Wizard->HotbarScrollAction, FInputActionValue(Frame.HotbarScroll));
+	}
+}
+
+void UInputReplaySubsystem::OnWaveStarted(int32 Wave)
+{
+	const uint32 StepCount = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetStepCount();
+	UE_LOG(LogTemp, Log, TEXT("InputReplay: Wave %d started on step %u with %d kills so far"), Wave, StepCount, ZombiesKilled);
+}
+
+void UInputReplaySubsystem::OnZombieDied(AZombieCharacter* Zombie)
+{
+	ZombiesKilled++;
+}
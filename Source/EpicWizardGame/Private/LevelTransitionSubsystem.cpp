@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelTransitionSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+ULevelTransitionSubsystem* ULevelTransitionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<ULevelTransitionSubsystem>() : nullptr;
+}
+
+void ULevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &ULevelTransitionSubsystem::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ULevelTransitionSubsystem::OnPostLoadMap);
+}
+
+void ULevelTransitionSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	Super::Deinitialize();
+}
+
+FString ULevelTransitionSubsystem::ResolveLevelPackage(const FString& LevelName) const
+{
+	if (FPackageName::IsValidLongPackageName(LevelName))
+	{
+		return LevelName;
+	}
+
+	return LevelsPath / LevelName;
+}
+
+void ULevelTransitionSubsystem::PreloadLevel(const FString& LevelName)
+{
+	const FString PackageName = ResolveLevelPackage(LevelName);
+	if (PackageName == PreloadPackageName && (PreloadedPackage || bPreloadInFlight))
+	{
+		return;
+	}
+
+	// One map at a time, dropping the old reference lets GC reclaim it
+	PreloadPackageName = PackageName;
+	PreloadedPackage = nullptr;
+	bTravelWhenLoaded = false;
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogTemp, Log, TEXT("LevelTransition: Preloading %s"), *PackageName);
+	bPreloadInFlight = true;
+	LoadPackageAsync(PackageName,
+		FLoadPackageAsyncDelegate::CreateUObject(this, &ULevelTransitionSubsystem::OnLevelPackageLoaded));
+}
+
+bool ULevelTransitionSubsystem::IsLevelPreloaded(const FString& LevelName) const
+{
+	return PreloadedPackage && PreloadPackageName == ResolveLevelPackage(LevelName);
+}
+
+void ULevelTransitionSubsystem::TravelToLevel(const FString& LevelName)
+{
+	TravelRequestTime = FPlatformTime::Seconds();
+
+	PreloadLevel(LevelName);
+	if (PreloadedPackage)
+	{
+		OpenPreloadedLevel();
+		return;
+	}
+
+	// Keep the title screen responsive and switch over from the load callback
+	bTravelWhenLoaded = true;
+	UE_LOG(LogTemp, Log, TEXT("LevelTransition: Waiting for %s to finish loading before travel"), *PreloadPackageName);
+}
+
+void ULevelTransitionSubsystem::TravelToGameplayLevel()
+{
+	TravelToLevel(TitleScreenPreloadLevel);
+}
+
+void ULevelTransitionSubsystem::OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	if (PackageName.ToString() != PreloadPackageName)
+	{
+		// A newer preload replaced this one
+		return;
+	}
+
+	bPreloadInFlight = false;
+
+	if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LevelTransition: Failed to preload %s"), *PreloadPackageName);
+
+		// Fall back to a blocking load rather than leaving the player on the title screen
+		if (bTravelWhenLoaded)
+		{
+			OpenPreloadedLevel();
+		}
+		return;
+	}
+
+	PreloadedPackage = LoadedPackage;
+	UE_LOG(LogTemp, Log, TEXT("LevelTransition: Preloaded %s in %.1fms"), *PreloadPackageName, (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+
+	if (bTravelWhenLoaded)
+	{
+		OpenPreloadedLevel();
+	}
+}
+
+void ULevelTransitionSubsystem::OpenPreloadedLevel()
+{
+	bTravelWhenLoaded = false;
+	UGameplayStatics::OpenLevel(GetGameInstance(), FName(*PreloadPackageName));
+}
+
+void ULevelTransitionSubsystem::OnPreLoadMap(const FString& MapName)
+{
+	// Open Level called directly still gets the preloaded package, but nobody started the clock
+	if (TravelRequestTime <= 0.0)
+	{
+		TravelRequestTime = FPlatformTime::Seconds();
+	}
+}
+
+void ULevelTransitionSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (!LoadedWorld || LoadedWorld->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	// The map is live now (or we went somewhere else), release our hold on the package
+	PreloadedPackage = nullptr;
+	PreloadPackageName.Reset();
+	bPreloadInFlight = false;
+
+	if (TravelRequestTime > 0.0)
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ULevelTransitionSubsystem::OnFirstFrameAfterTravel);
+	}
+
+	// Start streaming the gameplay map while the player reads the title screen
+	FString CurrentLevelName = LoadedWorld->GetMapName();
+	CurrentLevelName.RemoveFromStart(LoadedWorld->StreamingLevelsPrefix);
+	if (CurrentLevelName.Contains(TEXT("TitleScreen")) && !TitleScreenPreloadLevel.IsEmpty())
+	{
+		PreloadLevel(TitleScreenPreloadLevel);
+	}
+}
+
+void ULevelTransitionSubsystem::OnFirstFrameAfterTravel()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	LastTimeToInteractiveMs = static_cast<float>((FPlatformTime::Seconds() - TravelRequestTime) * 1000.0);
+	TravelRequestTime = 0.0;
+
+	UE_LOG(LogTemp, Warning, TEXT("LevelTransition: First interactive frame %.1fms after travel request"), LastTimeToInteractiveMs);
+}
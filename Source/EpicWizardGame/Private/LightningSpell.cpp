@@ -4,11 +4,12 @@
 #include "WizardCharacter.h"
 #include "ZombieCharacter.h"
 #include "Camera/CameraComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "SpellProjectile.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "GameplayScratch.h"
+#include "CosmeticEffectSubsystem.h"
 #include "Engine/DamageEvents.h"
-#include "GameFramework/ProjectileMovementComponent.h"
 
 ALightningSpell::ALightningSpell()
 {
@@ -19,25 +20,18 @@ ALightningSpell::ALightningSpell()
 	Cooldown = 4.0f; // Slow recovery time
 }
 
-void ALightningSpell::Execute(AWizardCharacter* Caster)
+bool ALightningSpell::Execute(AWizardCharacter* Caster)
 {
 	if (!Caster)
 	{
-		return;
-	}
-
-	// Only go on cooldown when we actually hit a zombie
-	if (!CanCast())
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Lightning: On cooldown (%.2fs remaining)"), GetCooldownRemaining());
-		return;
+		return false;
 	}
 
 	FVector AimOrigin;
 	FVector AimDirection;
 	if (!Caster->GetAimData(AimOrigin, AimDirection))
 	{
-		return;
+		return false;
 	}
 
 	// Raycast forward to find a zombie
@@ -59,7 +53,7 @@ void ALightningSpell::Execute(AWizardCharacter* Caster)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Lightning: No target found"));
 		// No cooldown consumed on miss
-		return;
+		return false;
 	}
 
 	// Check if we hit a zombie
@@ -67,14 +61,13 @@ void ALightningSpell::Execute(AWizardCharacter* Caster)
 	if (!TargetZombie)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Lightning: Hit non-zombie target"));
-		return;
+		return false;
 	}
 
 	FVector StrikeLocation = HitResult.Location;
 
-	// Mark ownership and start cooldown only after confirming a valid target
+	// Mark ownership only after confirming a valid target; returning true puts the slot on cooldown
 	OwnerWizard = Caster;
-	StartCooldown();
 
 	// Deal damage to primary target
 	FDamageEvent DamageEvent;
@@ -83,63 +76,49 @@ void ALightningSpell::Execute(AWizardCharacter* Caster)
 	UE_LOG(LogTemp, Log, TEXT("Lightning struck %s for %f damage!"), *TargetZombie->GetName(), BaseDamage);
 
 	// Find all zombies in AOE radius
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AZombieCharacter::StaticClass(), FoundActors);
-
 	int32 AOEHits = 0;
 	float AOEDamage = BaseDamage * AOEDamageMultiplier;
 
-	for (AActor* Actor : FoundActors)
+	if (const UZombieSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>())
 	{
-		AZombieCharacter* Zombie = Cast<AZombieCharacter>(Actor);
-		if (!Zombie || Zombie == TargetZombie)
-		{
-			continue;
-		}
+		FGameplayScratchScope Scratch;
+		TScratchArray<AZombieCharacter*> FoundZombies;
+		Grid->QueryRadius(StrikeLocation, AOERadius, FoundZombies);
 
-		float Distance = FVector::Dist(Zombie->GetActorLocation(), StrikeLocation);
-		if (Distance <= AOERadius)
+		for (AZombieCharacter* Zombie : FoundZombies)
 		{
-			Zombie->TakeDamage(AOEDamage, DamageEvent, Caster->GetController(), this);
-			AOEHits++;
+			if (Zombie == TargetZombie)
+			{
+				continue;
+			}
+
+			float Distance = FVector::Dist(Zombie->GetActorLocation(), StrikeLocation);
+			if (Distance <= AOERadius)
+			{
+				Zombie->TakeDamage(AOEDamage, DamageEvent, Caster->GetController(), this);
+				AOEHits++;
+			}
 		}
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Lightning AOE hit %d additional zombies"), AOEHits);
 
-	// Spawn projectile visual (lightning bolt) that drops from above the strike point
-	if (ProjectileClass)
+	// Visual-only bolt dropping from above the strike point; damage is already applied
+	if (UCosmeticEffectSubsystem* Effects = GetWorld()->GetSubsystem<UCosmeticEffectSubsystem>())
 	{
-		FVector SpawnLocation = StrikeLocation + FVector(0.0f, 0.0f, LightningStrikeHeight);
-		FVector Direction = FVector(0.0f, 0.0f, -1.0f);
-
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Owner = Caster;
-		SpawnParams.Instigator = Caster;
-
-		if (ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(
-			ProjectileClass,
-			SpawnLocation,
-			Direction.Rotation(),
-			SpawnParams))
+		FCosmeticEffectDesc Bolt;
+		Bolt.Type = ECosmeticEffectType::LightningBolt;
+		Bolt.Location = StrikeLocation + FVector(0.0f, 0.0f, LightningStrikeHeight);
+		Bolt.Direction = FVector(0.0f, 0.0f, -1.0f);
+		Bolt.Speed = LightningStrikeSpeed;
+		Bolt.Duration = LightningStrikeHeight / FMath::Max(LightningStrikeSpeed, 1.0f);
+		if (ProjectileClass)
 		{
-			// Damage already applied via raycast/AOE; this is visual-only
-			if (UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>())
-			{
-				const float OriginalSpeed = Movement->InitialSpeed;
-				Movement->InitialSpeed = LightningStrikeSpeed;
-				Movement->MaxSpeed = LightningStrikeSpeed;
-				Projectile->InitializeProjectile(Direction, 0.0f);
-				// Restore configured speed for future use of this projectile class
-				Movement->InitialSpeed = OriginalSpeed;
-				Movement->MaxSpeed = OriginalSpeed;
-			}
-			else
-			{
-				Projectile->InitializeProjectile(Direction, 0.0f);
-			}
+			Bolt.CopyAppearanceFrom(ProjectileClass->GetDefaultObject<ASpellProjectile>());
 		}
+		Effects->PlayEffect(Bolt);
 	}
 
+	return true;
 }
 
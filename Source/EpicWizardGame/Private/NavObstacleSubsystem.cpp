@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NavObstacleSubsystem.h"
+#include "GameplayEventBus.h"
+#include "NavModifierComponent.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "EngineUtils.h"
+
+void UNavObstacleSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UGameplayEventBus* EventBus = Collection.InitializeDependency<UGameplayEventBus>();
+	if (EventBus)
+	{
+		WaveStartedHandle = EventBus->OnWaveStarted.AddUObject(this, &UNavObstacleSubsystem::OnWaveStarted);
+		WaveCompletedHandle = EventBus->OnWaveCompleted.AddUObject(this, &UNavObstacleSubsystem::OnWaveCompleted);
+		RunRestartedHandle = EventBus->OnRunRestarted.AddUObject(this, &UNavObstacleSubsystem::FlushDeferredRemovals);
+	}
+}
+
+void UNavObstacleSubsystem::Deinitialize()
+{
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveStarted.Remove(WaveStartedHandle);
+		EventBus->OnWaveCompleted.Remove(WaveCompletedHandle);
+		EventBus->OnRunRestarted.Remove(RunRestartedHandle);
+	}
+
+	PendingObstacles.Reset();
+	DeferredRemovals.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNavObstacleSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The project default is DynamicModifiersOnly, but a navmesh actor saved with its own setting overrides it
+	for (TActorIterator<ARecastNavMesh> It(&InWorld); It; ++It)
+	{
+		const ERuntimeGenerationType Generation = It->GetRuntimeGenerationMode();
+		if (Generation == ERuntimeGenerationType::Static)
+		{
+			UE_LOG(LogTemp, Error, TEXT("NavObstacleSubsystem: %s has static runtime generation, turrets won't cut the navmesh. Set Runtime Generation to Dynamic Modifiers Only"),
+				*It->GetName());
+		}
+		else if (Generation != ERuntimeGenerationType::DynamicModifiersOnly)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("NavObstacleSubsystem: %s rebuilds tiles from full geometry, every turret change will cost a full tile build. Set Runtime Generation to Dynamic Modifiers Only"),
+				*It->GetName());
+		}
+	}
+}
+
+void UNavObstacleSubsystem::QueueObstacle(UNavModifierComponent* Modifier)
+{
+	if (Modifier)
+	{
+		PendingObstacles.AddUnique(Modifier);
+	}
+}
+
+void UNavObstacleSubsystem::RemoveObstacle(AActor* ObstacleOwner)
+{
+	if (!ObstacleOwner)
+	{
+		return;
+	}
+
+	if (!bWaveRunning)
+	{
+		ObstacleOwner->Destroy();
+		return;
+	}
+
+	// Its modifier stays registered, so the tiles under it aren't rebuilt until the break
+	ObstacleOwner->SetActorHiddenInGame(true);
+	ObstacleOwner->SetActorEnableCollision(false);
+	DeferredRemovals.AddUnique(ObstacleOwner);
+}
+
+void UNavObstacleSubsystem::OnWaveStarted(int32 Wave)
+{
+	bWaveRunning = true;
+}
+
+void UNavObstacleSubsystem::OnWaveCompleted(int32 Wave)
+{
+	bWaveRunning = false;
+	FlushDeferredRemovals();
+}
+
+void UNavObstacleSubsystem::FlushDeferredRemovals()
+{
+	bWaveRunning = false;
+
+	bool bRemovedAny = false;
+	for (const TWeakObjectPtr<AActor>& ObstacleOwner : DeferredRemovals)
+	{
+		if (AActor* Owner = ObstacleOwner.Get())
+		{
+			Owner->Destroy();
+			bRemovedAny = true;
+		}
+	}
+	DeferredRemovals.Reset();
+
+	// Removing the holes dirties tiles too; hold the next wave until they are built
+	if (bRemovedAny)
+	{
+		bAwaitingNavBuild = true;
+		LastChangeFrame = GFrameCounter;
+	}
+}
+
+bool UNavObstacleSubsystem::IsRebuildPending() const
+{
+	return PendingObstacles.Num() > 0 || bAwaitingNavBuild;
+}
+
+void UNavObstacleSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	int32 NumRegistered = 0;
+	while (PendingObstacles.Num() > 0 && NumRegistered < MaxObstaclesPerFrame)
+	{
+		UNavModifierComponent* Modifier = PendingObstacles[0].Get();
+		PendingObstacles.RemoveAt(0, EAllowShrinking::No);
+
+		if (Modifier && !Modifier->IsRegistered() && Modifier->GetOwner() && !Modifier->GetOwner()->IsActorBeingDestroyed())
+		{
+			Modifier->RegisterComponent();
+			bAwaitingNavBuild = true;
+			LastChangeFrame = GFrameCounter;
+			NumRegistered++;
+		}
+	}
+
+	if (!bAwaitingNavBuild || PendingObstacles.Num() > 0)
+	{
+		return;
+	}
+
+	// A new modifier only queues its dirty area; the build hasn't started yet on the frame it registers
+	if (GFrameCounter <= LastChangeFrame + NavSettleFrames)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys && (NavSys->HasDirtyAreasQueued() || NavSys->IsNavigationBuildInProgress()))
+	{
+		return;
+	}
+
+	bAwaitingNavBuild = false;
+	UE_LOG(LogTemp, Log, TEXT("NavObstacleSubsystem: Navmesh rebuilt around turrets"));
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnNavMeshRebuilt.Broadcast();
+	}
+}
+
+TStatId UNavObstacleSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNavObstacleSubsystem, STATGROUP_Tickables);
+}
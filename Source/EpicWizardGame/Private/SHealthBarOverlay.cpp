@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SHealthBarOverlay.h"
+#include "HealthBarSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+#include "Rendering/DrawElements.h"
+
+void SHealthBarOverlay::Construct(const FArguments& InArgs, UHealthBarSubsystem* InRegistry, APlayerController* InPlayerController)
+{
+	Registry = InRegistry;
+	PlayerController = InPlayerController;
+	BackgroundColor = InArgs._BackgroundColor;
+	HealthyColor = InArgs._HealthyColor;
+	CriticalColor = InArgs._CriticalColor;
+	WhiteBrush = FCoreStyle::Get().GetBrush(TEXT("WhiteBrush"));
+
+	// Bars follow moving actors, so repaint every frame and never hit-test
+	SetVisibility(EVisibility::HitTestInvisible);
+	ForceVolatile(true);
+}
+
+FVector2D SHealthBarOverlay::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Fills whatever slot it's given (the viewport)
+	return FVector2D::ZeroVector;
+}
+
+int32 SHealthBarOverlay::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const UHealthBarSubsystem* BarRegistry = Registry.Get();
+	const APlayerController* PC = PlayerController.Get();
+	const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	if (!BarRegistry || !LocalPlayer || !LocalPlayer->ViewportClient || !LocalPlayer->ViewportClient->Viewport)
+	{
+		return LayerId;
+	}
+
+	// One view-projection matrix for every bar this frame
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return LayerId;
+	}
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	if (ViewRect.Width() <= 0 || ViewRect.Height() <= 0)
+	{
+		return LayerId;
+	}
+
+	// Projection works in viewport pixels; the overlay is laid out in DPI-scaled units
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	const FVector2D PixelToLocal(LocalSize.X / ViewRect.Width(), LocalSize.Y / ViewRect.Height());
+
+	const int32 BackgroundLayer = LayerId;
+	const int32 FillLayer = LayerId + 1;
+
+	for (const FHealthBarEntry& Entry : BarRegistry->GetEntries())
+	{
+		if (Entry.HealthPercent >= 1.0f)
+		{
+			continue;
+		}
+
+		const AActor* Owner = Entry.Owner.Get();
+		if (!Owner || Owner->IsHidden())
+		{
+			continue;
+		}
+
+		const FVector WorldLocation = Owner->GetActorLocation() + FVector(0.0f, 0.0f, Entry.VerticalOffset);
+
+		FVector2D ScreenPosition;
+		if (!FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPosition))
+		{
+			continue;
+		}
+
+		const FVector2D Center = (ScreenPosition - FVector2D(ViewRect.Min)) * PixelToLocal;
+		const FVector2D TopLeft = Center - Entry.Size * 0.5f;
+
+		if (TopLeft.X > LocalSize.X || TopLeft.Y > LocalSize.Y || TopLeft.X + Entry.Size.X < 0.0f || TopLeft.Y + Entry.Size.Y < 0.0f)
+		{
+			continue;
+		}
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			BackgroundLayer,
+			AllottedGeometry.ToPaintGeometry(Entry.Size, FSlateLayoutTransform(TopLeft)),
+			WhiteBrush,
+			ESlateDrawEffect::None,
+			BackgroundColor);
+
+		const float Percent = FMath::Max(Entry.HealthPercent, 0.0f);
+		if (Percent > 0.0f)
+		{
+			const FVector2D FillSize(Entry.Size.X * Percent, Entry.Size.Y);
+			const FLinearColor FillColor = FLinearColor::LerpUsingHSV(CriticalColor, HealthyColor, Percent);
+
+			FSlateDrawElement::MakeBox(
+				OutDrawElements,
+				FillLayer,
+				AllottedGeometry.ToPaintGeometry(FillSize, FSlateLayoutTransform(TopLeft)),
+				WhiteBrush,
+				ESlateDrawEffect::None,
+				FillColor);
+		}
+	}
+
+	return FillLayer;
+}
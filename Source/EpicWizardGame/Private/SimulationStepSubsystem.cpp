@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SimulationStepSubsystem.h"
+#include "GameplayTimerSubsystem.h"
+#include "Misc/CommandLine.h"
+
+DECLARE_STATS_GROUP(TEXT("Simulation Step"), STATGROUP_SimulationStep, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Step"), STAT_SimulationStep_Step, STATGROUP_SimulationStep);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Steps This Frame"), STAT_SimulationStep_Steps, STATGROUP_SimulationStep);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Step Rate (Hz)"), STAT_SimulationStep_Rate, STATGROUP_SimulationStep);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timed Callbacks"), STAT_SimulationStep_Timed, STATGROUP_SimulationStep);
+
+namespace
+{
+	/** Seconds of frames that fit the budget before stepping back up towards the target rate */
+	constexpr float StepRateRecoveryDelay = 5.0f;
+}
+
+void USimulationStepSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Timers advance as part of each step, so they need to exist first
+	Collection.InitializeDependency<UGameplayTimerSubsystem>();
+
+	float CommandLineRate = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SimRate="), CommandLineRate))
+	{
+		SetStepRate(CommandLineRate);
+	}
+}
+
+void USimulationStepSubsystem::RunForDuration(ESimulationStepGroup Group, const UObject* Owner, float Duration, TFunction<void(float)> Callback)
+{
+	if (!Owner || Duration <= 0.0f || !Callback)
+	{
+		return;
+	}
+
+	FTimedStep& TimedStep = TimedSteps[static_cast<uint8>(Group)].AddDefaulted_GetRef();
+	TimedStep.Owner = Owner;
+	TimedStep.RemainingTime = Duration;
+	TimedStep.Callback = MoveTemp(Callback);
+}
+
+void USimulationStepSubsystem::SetStepRate(float NewStepRate)
+{
+	TargetStepRate = FMath::Clamp(NewStepRate, MinStepRate, MaxStepRate);
+	StepRate = TargetStepRate;
+	TimeSinceOverload = 0.0f;
+
+	UE_LOG(LogTemp, Log, TEXT("SimulationStep: Stepping at %.1f Hz"), StepRate);
+}
+
+void USimulationStepSubsystem::SetStepRateLocked(bool bLocked)
+{
+	bStepRateLocked = bLocked;
+
+	if (bStepRateLocked && StepRate != TargetStepRate)
+	{
+		StepRate = TargetStepRate;
+		TimeSinceOverload = 0.0f;
+		UE_LOG(LogTemp, Log, TEXT("SimulationStep: Rate locked at %.1f Hz"), StepRate);
+	}
+}
+
+void USimulationStepSubsystem::Step()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SimulationStep_Step);
+
+	const float StepSeconds = GetStepSeconds();
+	SimulationTime += StepSeconds;
+	StepCount++;
+
+	// Zombie AI, animation and status effect timers first, so everything below sees this step's state
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->AdvanceSimulation(StepSeconds);
+	}
+
+	int32 NumTimed = 0;
+	for (uint8 Group = 0; Group < static_cast<uint8>(ESimulationStepGroup::Count); Group++)
+	{
+		StepDelegates[Group].Broadcast(StepSeconds);
+
+		// Index loop: callbacks may start new timed steps (a blast spawning another)
+		TArray<FTimedStep>& GroupTimedSteps = TimedSteps[Group];
+		for (int32 i = 0; i < GroupTimedSteps.Num(); i++)
+		{
+			if (!GroupTimedSteps[i].Owner.IsValid())
+			{
+				continue;
+			}
+
+			// Copy out: the array can grow during the call
+			TFunction<void(float)> Callback = GroupTimedSteps[i].Callback;
+			Callback(StepSeconds);
+			GroupTimedSteps[i].RemainingTime -= StepSeconds;
+		}
+
+		GroupTimedSteps.RemoveAllSwap([](const FTimedStep& TimedStep)
+		{
+			return !TimedStep.Owner.IsValid() || TimedStep.RemainingTime <= 0.0f;
+		}, EAllowShrinking::No);
+
+		NumTimed += GroupTimedSteps.Num();
+	}
+
+	SET_DWORD_STAT(STAT_SimulationStep_Timed, NumTimed);
+}
+
+void USimulationStepSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Accumulator += DeltaTime;
+
+	// Tolerance so a fixed frame time equal to the step (-usefixedtimestep, replays) gives exactly one step per frame
+	int32 NumSteps = FMath::FloorToInt32(Accumulator * StepRate + UE_KINDA_SMALL_NUMBER);
+
+	if (NumSteps > MaxStepsPerFrame)
+	{
+		// Under load: take bigger steps rather than fall behind real time
+		if (StepRate > MinStepRate && !bStepRateLocked)
+		{
+			StepRate = FMath::Max(MinStepRate, StepRate * 0.5f);
+			NumSteps = FMath::FloorToInt32(Accumulator * StepRate + UE_KINDA_SMALL_NUMBER);
+			UE_LOG(LogTemp, Log, TEXT("SimulationStep: Frame overran the step budget, lowering rate to %.1f Hz"), StepRate);
+		}
+
+		// Still too far behind (a hitch or a load): drop the backlog instead of catching up over several frames
+		if (NumSteps > MaxStepsPerFrame)
+		{
+			NumSteps = MaxStepsPerFrame;
+			Accumulator = NumSteps / StepRate;
+		}
+
+		TimeSinceOverload = 0.0f;
+	}
+	else if (StepRate < TargetStepRate)
+	{
+		TimeSinceOverload += DeltaTime;
+		if (TimeSinceOverload >= StepRateRecoveryDelay)
+		{
+			StepRate = FMath::Min(TargetStepRate, StepRate * 2.0f);
+			TimeSinceOverload = 0.0f;
+		}
+	}
+
+	for (int32 i = 0; i < NumSteps; i++)
+	{
+		Accumulator -= 1.0 / StepRate;
+		Step();
+	}
+
+	SET_DWORD_STAT(STAT_SimulationStep_Steps, NumSteps);
+	SET_FLOAT_STAT(STAT_SimulationStep_Rate, StepRate);
+}
+
+TStatId USimulationStepSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimulationStepSubsystem, STATGROUP_Tickables);
+}
@@ -13,44 +13,16 @@ void ASpellBase::BeginPlay()
 	Super::BeginPlay();
 }
 
-void ASpellBase::Execute(AWizardCharacter* Caster)
+bool ASpellBase::Execute(AWizardCharacter* Caster)
 {
-	// Base implementation does nothing - override in child classes
+	// Base implementation only records the caster - override in child classes.
+	// Cooldowns are kept by the caster's spellbook.
 	if (!Caster)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("SpellBase::Execute - No caster provided!"));
-		return;
-	}
-
-	if (!CanCast())
-	{
-		const float Remaining = GetCooldownRemaining();
-		UE_LOG(LogTemp, Warning, TEXT("SpellBase::Execute - %s on cooldown (%.2fs remaining)"), *SpellName, Remaining);
-		return;
+		return false;
 	}
 
 	OwnerWizard = Caster;
-	StartCooldown();
-
-	const float Remaining = GetCooldownRemaining();
-	UE_LOG(LogTemp, Log, TEXT("SpellBase::Execute - %s cast. Next shot available in %.2fs"), *SpellName, Remaining);
-}
-
-bool ASpellBase::CanCast() const
-{
-	float TimeSinceLastCast = GetWorld()->GetTimeSeconds() - LastCastTime;
-	return TimeSinceLastCast >= Cooldown;
+	return true;
 }
-
-float ASpellBase::GetCooldownRemaining() const
-{
-	float TimeSinceLastCast = GetWorld()->GetTimeSeconds() - LastCastTime;
-	float Remaining = Cooldown - TimeSinceLastCast;
-	return FMath::Max(0.0f, Remaining);
-}
-
-void ASpellBase::StartCooldown()
-{
-	LastCastTime = GetWorld()->GetTimeSeconds();
-}
-
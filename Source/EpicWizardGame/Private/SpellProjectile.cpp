@@ -5,6 +5,8 @@
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "ZombieCharacter.h"
+#include "EpicWizardGame.h"
+#include "GameplayTimerSubsystem.h"
 #include "Engine/DamageEvents.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
@@ -18,6 +20,7 @@ ASpellProjectile::ASpellProjectile()
 	CollisionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	CollisionSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
 	CollisionSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+	CollisionSphere->SetCollisionResponseToChannel(ECC_Zombie, ECR_Block);
 	CollisionSphere->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
 	CollisionSphere->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Block);
 	RootComponent = CollisionSphere;
@@ -44,7 +47,14 @@ void ASpellProjectile::BeginPlay()
 	Super::BeginPlay();
 
 	// Auto-destroy after lifetime
-	SetLifeSpan(Lifetime);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->SetActorLifeSpan(this, Lifetime);
+	}
+	else
+	{
+		SetLifeSpan(Lifetime);
+	}
 }
 
 void ASpellProjectile::InitializeProjectile(const FVector& Direction, float InDamage)
@@ -65,6 +75,7 @@ void ASpellProjectile::InitializeProjectile(const FVector& Direction, float InDa
 		CollisionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 		CollisionSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
 		CollisionSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+		CollisionSphere->SetCollisionResponseToChannel(ECC_Zombie, ECR_Block);
 		CollisionSphere->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
 		CollisionSphere->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Block);
 		// Also allow overlaps so we can still deal damage if block isn't triggered by collision settings
@@ -110,15 +121,13 @@ void ASpellProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, U
 				const float OriginalSpeed = MovementComp->MaxWalkSpeed;
 				MovementComp->MaxWalkSpeed = OriginalSpeed * FreezeSpeedMultiplier;
 
-				FTimerHandle FreezeTimer;
-				TWeakObjectPtr<UCharacterMovementComponent> MovementWeak = MovementComp;
-				GetWorld()->GetTimerManager().SetTimer(FreezeTimer, [MovementWeak, OriginalSpeed]()
+				if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
 				{
-					if (MovementWeak.IsValid())
+					Timers->SetTimer(EGameplayTimerCategory::StatusEffect, FreezeDuration, FSimpleDelegate::CreateWeakLambda(MovementComp, [MovementComp, OriginalSpeed]()
 					{
-						MovementWeak->MaxWalkSpeed = OriginalSpeed;
-					}
-				}, FreezeDuration, false);
+						MovementComp->MaxWalkSpeed = OriginalSpeed;
+					}));
+				}
 			}
 		}
 
@@ -176,15 +185,13 @@ void ASpellProjectile::OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* Ot
 				const float OriginalSpeed = MovementComp->MaxWalkSpeed;
 				MovementComp->MaxWalkSpeed = OriginalSpeed * FreezeSpeedMultiplier;
 
-				FTimerHandle FreezeTimer;
-				TWeakObjectPtr<UCharacterMovementComponent> MovementWeak = MovementComp;
-				GetWorld()->GetTimerManager().SetTimer(FreezeTimer, [MovementWeak, OriginalSpeed]()
+				if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
 				{
-					if (MovementWeak.IsValid())
+					Timers->SetTimer(EGameplayTimerCategory::StatusEffect, FreezeDuration, FSimpleDelegate::CreateWeakLambda(MovementComp, [MovementComp, OriginalSpeed]()
 					{
-						MovementWeak->MaxWalkSpeed = OriginalSpeed;
-					}
-				}, FreezeDuration, false);
+						MovementComp->MaxWalkSpeed = OriginalSpeed;
+					}));
+				}
 			}
 		}
 
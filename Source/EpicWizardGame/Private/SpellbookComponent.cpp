@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpellbookComponent.h"
+#include "SpellBase.h"
+#include "WizardCharacter.h"
+
+USpellbookComponent::USpellbookComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void USpellbookComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (ASpellBase* Spell : SlotSpells)
+	{
+		if (IsValid(Spell))
+		{
+			Spell->Destroy();
+		}
+	}
+	SlotSpells.Reset();
+	CooldownEndTimes.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+ASpellBase* USpellbookComponent::EnsureSlotSpell(int32 SlotIndex, TSubclassOf<ASpellBase> SpellClass)
+{
+	if (SlotIndex >= SlotSpells.Num())
+	{
+		SlotSpells.SetNumZeroed(SlotIndex + 1);
+		CooldownEndTimes.SetNumZeroed(SlotIndex + 1);
+	}
+
+	ASpellBase* Spell = SlotSpells[SlotIndex];
+	if (IsValid(Spell) && Spell->GetClass() == SpellClass)
+	{
+		return Spell;
+	}
+
+	if (IsValid(Spell))
+	{
+		Spell->Destroy();
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = GetOwner();
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	Spell = GetWorld()->SpawnActor<ASpellBase>(SpellClass, FTransform::Identity, SpawnParams);
+	SlotSpells[SlotIndex] = Spell;
+	CooldownEndTimes[SlotIndex] = 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("Spellbook: Created %s for slot %d"), *GetNameSafe(SpellClass), SlotIndex + 1);
+	return Spell;
+}
+
+ESpellCastResult USpellbookComponent::CastSlot(int32 SlotIndex, TSubclassOf<ASpellBase> SpellClass)
+{
+	if (SlotIndex < 0 || !SpellClass)
+	{
+		return ESpellCastResult::NoSpell;
+	}
+
+	ASpellBase* Spell = EnsureSlotSpell(SlotIndex, SpellClass);
+	if (!Spell)
+	{
+		return ESpellCastResult::NoSpell;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < CooldownEndTimes[SlotIndex])
+	{
+		return ESpellCastResult::OnCooldown;
+	}
+
+	if (!Spell->Execute(Cast<AWizardCharacter>(GetOwner())))
+	{
+		return ESpellCastResult::Failed;
+	}
+
+	CooldownEndTimes[SlotIndex] = Now + Spell->Cooldown;
+
+	return ESpellCastResult::Cast;
+}
+
+float USpellbookComponent::GetCooldownRemaining(int32 SlotIndex) const
+{
+	if (!CooldownEndTimes.IsValidIndex(SlotIndex))
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(0.0f, static_cast<float>(CooldownEndTimes[SlotIndex] - GetWorld()->GetTimeSeconds()));
+}
+
+void USpellbookComponent::ResetCooldowns()
+{
+	for (double& EndTime : CooldownEndTimes)
+	{
+		EndTime = 0.0;
+	}
+}
+
+ASpellBase* USpellbookComponent::GetSpellInSlot(int32 SlotIndex) const
+{
+	return SlotSpells.IsValidIndex(SlotIndex) ? SlotSpells[SlotIndex] : nullptr;
+}
@@ -1,8 +1,13 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Tower.h"
-#include "Components/WidgetComponent.h"
+#include "AttackSlotComponent.h"
+#include "ZombieCharacter.h"
+#include "EpicWizardGame.h"
+#include "HealthBarSubsystem.h"
+#include "GameplayEventBus.h"
 #include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 
@@ -23,13 +28,13 @@ ATower::ATower()
 	AttackCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	AttackCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 	AttackCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+	AttackCollision->SetCollisionResponseToChannel(ECC_Zombie, ECollisionResponse::ECR_Overlap);
+	AttackCollision->SetGenerateOverlapEvents(true);
+	AttackCollision->OnComponentBeginOverlap.AddDynamic(this, &ATower::OnAttackCollisionBeginOverlap);
+	AttackCollision->OnComponentEndOverlap.AddDynamic(this, &ATower::OnAttackCollisionEndOverlap);
 
-	// Create floating health bar widget
-	HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidget->SetupAttachment(RootComponent);
-	HealthBarWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 300.0f)); // Above tower
-	HealthBarWidget->SetWidgetSpace(EWidgetSpace::Screen); // Always face camera
-	HealthBarWidget->SetDrawSize(FVector2D(300.0f, 30.0f));
+	// Attack slots around the collision box so zombies spread out instead of piling onto the origin
+	AttackSlots = CreateDefaultSubobject<UAttackSlotComponent>(TEXT("AttackSlots"));
 }
 
 // Called when the game starts or when spawned
@@ -37,19 +42,27 @@ void ATower::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Check if we're in a menu screen - if so, hide health bar
-	FString CurrentLevelName = GetWorld()->GetMapName();
-	CurrentLevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
-	if (CurrentLevelName.Contains(TEXT("TitleScreen")) || CurrentLevelName.Contains(TEXT("DeathScreen")))
+	// Initialize HP
+	CurrentHP = MaxHP;
+
+	// Floating health bar (drawn by the HUD overlay, which only exists in gameplay levels)
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
 	{
-		if (HealthBarWidget)
-		{
-			HealthBarWidget->SetVisibility(false);
-		}
+		HealthBarHandle = HealthBars->RegisterHealthBar(this, HealthBarHeight, HealthBarSize);
 	}
 
-	// Initialize HP
-	CurrentHP = MaxHP;
+	// Build the slot ring once the box has its final (possibly Blueprint-edited) size
+	AttackSlots->InitializeFromBox(AttackCollision);
+}
+
+void ATower::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->UnregisterHealthBar(HealthBarHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -67,6 +80,7 @@ float ATower::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, A
 	}
 
 	CurrentHP -= Damage;
+	UpdateHealthBar();
 
 	UE_LOG(LogTemp, Warning, TEXT("Tower took %f damage! Current HP: %f / %f"), Damage, CurrentHP, MaxHP);
 
@@ -92,11 +106,62 @@ void ATower::DestroyTower()
 	// Call blueprint event
 	BP_OnTowerDestroyed();
 
-	// Show death screen after a short delay (same cadence as player death)
-	FTimerHandle ReturnToDeathScreenTimer;
-	GetWorld()->GetTimerManager().SetTimer(ReturnToDeathScreenTimer, [this]()
+	// End the run after a short delay (same cadence as player death)
+	FTimerHandle RunLostTimer;
+	GetWorld()->GetTimerManager().SetTimer(RunLostTimer, FTimerDelegate::CreateWeakLambda(this, [this]()
 	{
-		UGameplayStatics::OpenLevel(this, FName("DeathScreen"));
-	}, 2.0f, false);
+		if (!bIsDestroyed)
+		{
+			return;
+		}
+
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			EventBus->OnRunLost.Broadcast();
+		}
+	}), 2.0f, false);
 }
 
+void ATower::ResetTower()
+{
+	SetCurrentHP(MaxHP);
+}
+
+void ATower::SetCurrentHP(float NewHP)
+{
+	CurrentHP = FMath::Clamp(NewHP, 0.0f, MaxHP);
+	bIsDestroyed = CurrentHP <= 0.0f;
+	UpdateHealthBar();
+
+	// Only restarts and rollbacks set HP directly
+	BP_OnRunRestarted();
+}
+
+void ATower::UpdateHealthBar()
+{
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->SetHealthPercent(HealthBarHandle, GetHealthPercent());
+	}
+}
+
+void ATower::OnAttackCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// Only the capsule counts; a zombie's other colliding primitives would end their overlap while it's still in range
+	AZombieCharacter* Zombie = Cast<AZombieCharacter>(OtherActor);
+	if (Zombie && OtherComp == Zombie->GetCapsuleComponent())
+	{
+		Zombie->AddTouchingStructure(this);
+	}
+}
+
+void ATower::OnAttackCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	AZombieCharacter* Zombie = Cast<AZombieCharacter>(OtherActor);
+	if (Zombie && OtherComp == Zombie->GetCapsuleComponent())
+	{
+		Zombie->RemoveTouchingStructure(this);
+	}
+}
@@ -2,21 +2,26 @@
 
 
 #include "Turret.h"
+#include "AttackSlotComponent.h"
 #include "ZombieCharacter.h"
+#include "EpicWizardGame.h"
+#include "HealthBarSubsystem.h"
+#include "NavObstacleSubsystem.h"
 #include "SpellProjectile.h"
-#include "Kismet/GameplayStatics.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "GameplayScratch.h"
+#include "SimulationStepSubsystem.h"
 #include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Components/SceneComponent.h"
-#include "Components/WidgetComponent.h"
-#include "Blueprint/UserWidget.h"
-#include "UObject/ConstructorHelpers.h"
-#include "UObject/UnrealType.h"
+#include "NavModifierComponent.h"
+#include "NavAreas/NavArea_Null.h"
 
 // Sets default values
 ATurret::ATurret()
 {
- 	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Targeting and firing run on the simulation step, nothing to do per frame
+	PrimaryActorTick.bCanEverTick = false;
 
 	SetCanBeDamaged(true);
 
@@ -31,20 +36,21 @@ ATurret::ATurret()
 	AttackCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	AttackCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 	AttackCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
-
-	// Create floating health bar widget (same as zombies/tower)
-	HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidget->SetupAttachment(RootComponent);
-	HealthBarWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 120.0f));
-	HealthBarWidget->SetWidgetSpace(EWidgetSpace::Screen);
-	HealthBarWidget->SetDrawSize(FVector2D(200.0f, 20.0f));
-
-	// Default to the shared floating health bar widget blueprint
-	static ConstructorHelpers::FClassFinder<UUserWidget> HealthBarWidgetBP(TEXT("/Game/WizardsLastStand/UI/WBP_FloatingHealthBar"));
-	if (HealthBarWidgetBP.Succeeded())
-	{
-		HealthBarWidget->SetWidgetClass(HealthBarWidgetBP.Class);
-	}
+	AttackCollision->SetCollisionResponseToChannel(ECC_Zombie, ECollisionResponse::ECR_Overlap);
+	AttackCollision->SetGenerateOverlapEvents(true);
+	AttackCollision->SetCanEverAffectNavigation(false);
+	AttackCollision->OnComponentBeginOverlap.AddDynamic(this, &ATurret::OnAttackCollisionBeginOverlap);
+	AttackCollision->OnComponentEndOverlap.AddDynamic(this, &ATurret::OnAttackCollisionEndOverlap);
+
+	// Attack slots around the collision box so zombies spread out around the turret
+	AttackSlots = CreateDefaultSubobject<UAttackSlotComponent>(TEXT("AttackSlots"));
+
+	// Nav obstacle over the turret meshes (the attack box is excluded above). Left unregistered
+	// until BeginPlay hands it to the nav obstacle subsystem
+	NavModifier = CreateDefaultSubobject<UNavModifierComponent>(TEXT("NavModifier"));
+	NavModifier->SetAreaClass(UNavArea_Null::StaticClass());
+	NavModifier->FailsafeExtent = FVector(60.0f, 60.0f, 100.0f);
+	NavModifier->bAutoRegister = false;
 }
 
 // Called when the game starts or when spawned
@@ -55,47 +61,47 @@ void ATurret::BeginPlay()
 	// Blueprint defaults can override "Can Be Damaged", so force it at runtime
 	SetCanBeDamaged(!bIsPreviewTurret);
 
-	// Ensure the widget exists and points at this turret (WBP_FloatingHealthBar expects an OwnerActor variable)
-	if (HealthBarWidget)
-	{
-		HealthBarWidget->InitWidget();
-		UE_LOG(LogTemp, Log, TEXT("Turret HealthBarWidget class: %s"), *GetNameSafe(HealthBarWidget->GetWidgetClass()));
+	// Initialize HP
+	CurrentHP = MaxHP;
+	RefreshHealthBarRegistration();
 
-		if (UUserWidget* UserWidget = HealthBarWidget->GetUserWidgetObject())
-		{
-			if (FObjectPropertyBase* OwnerActorProp = FindFProperty<FObjectPropertyBase>(UserWidget->GetClass(), TEXT("OwnerActor")))
-			{
-				if (OwnerActorProp->PropertyClass && OwnerActorProp->PropertyClass->IsChildOf(AActor::StaticClass()))
-				{
-					OwnerActorProp->SetObjectPropertyValue_InContainer(UserWidget, this);
-					UE_LOG(LogTemp, Log, TEXT("Turret health bar OwnerActor set to %s"), *GetName());
-				}
-			}
-		}
-	}
+	// Build the slot ring once the box has its final (possibly Blueprint-edited) size
+	AttackSlots->InitializeFromBox(AttackCollision);
 
-	// Check if we're in a menu screen - if so, hide health bar
-	FString CurrentLevelName = GetWorld()->GetMapName();
-	CurrentLevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
-	if (CurrentLevelName.Contains(TEXT("TitleScreen")) || CurrentLevelName.Contains(TEXT("DeathScreen")))
+	// Placed turrets become navmesh obstacles; previews never do
+	if (!bIsPreviewTurret)
 	{
-		if (HealthBarWidget)
+		if (UNavObstacleSubsystem* NavObstacles = GetWorld()->GetSubsystem<UNavObstacleSubsystem>())
 		{
-			HealthBarWidget->SetVisibility(false);
+			NavObstacles->QueueObstacle(NavModifier);
 		}
 	}
 
-	// Initialize HP
-	CurrentHP = MaxHP;
-
 	FireTimer = FireRate;
+
+	if (USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>())
+	{
+		SimulationStepHandle = Simulation->OnStep(ESimulationStepGroup::Turrets).AddUObject(this, &ATurret::SimulationStep);
+	}
 }
 
-// Called every frame
-void ATurret::Tick(float DeltaTime)
+void ATurret::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>())
+	{
+		Simulation->OnStep(ESimulationStepGroup::Turrets).Remove(SimulationStepHandle);
+	}
+
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->UnregisterHealthBar(HealthBarHandle);
+	}
 
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATurret::SimulationStep(float StepSeconds)
+{
 	if (bIsDestroyed || bIsPreviewTurret)
 	{
 		return;
@@ -108,13 +114,25 @@ void ATurret::Tick(float DeltaTime)
 	if (NearestZombie && !NearestZombie->IsDead())
 	{
 		// Update fire timer
-		FireTimer -= DeltaTime;
+		FireTimer -= StepSeconds;
 
-		// Shoot if timer is ready
-		if (FireTimer <= 0.0f)
+		// Fire every shot that came due this step, so a fire rate faster than the step rate keeps its DPS.
+		// A non-positive fire rate would never catch up, so it fires once per step
+		if (FireRate <= 0.0f)
 		{
 			ShootAtTarget(NearestZombie);
-			FireTimer = FireRate;
+			FireTimer = 0.0f;
+		}
+		else
+		{
+			while (FireTimer <= 0.0f && !NearestZombie->IsDead())
+			{
+				ShootAtTarget(NearestZombie);
+				FireTimer += FireRate;
+			}
+
+			// The target died before the backlog was fired; don't bank the rest for the next one
+			FireTimer = FMath::Max(FireTimer, 0.0f);
 		}
 	}
 	else
@@ -147,6 +165,7 @@ float ATurret::TakeDamage(float Damage, FDamageEvent const& DamageEvent, AContro
 	}
 
 	CurrentHP -= AppliedDamage;
+	UpdateHealthBar();
 
 	UE_LOG(LogTemp, Warning, TEXT("Turret took %f damage! Current HP: %f / %f"), AppliedDamage, CurrentHP, MaxHP);
 
@@ -166,31 +185,98 @@ void ATurret::SetIsPreviewTurret(bool bIsPreview)
 
 	SetCanBeDamaged(!bIsPreviewTurret);
 
-	if (HealthBarWidget)
+	if (HasActorBegunPlay())
+	{
+		RefreshHealthBarRegistration();
+	}
+}
+
+void ATurret::RefreshHealthBarRegistration()
+{
+	UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>();
+	if (!HealthBars)
+	{
+		return;
+	}
+
+	const bool bWantsHealthBar = !bIsPreviewTurret && !bIsDestroyed;
+	if (bWantsHealthBar && HealthBarHandle == INDEX_NONE)
+	{
+		HealthBarHandle = HealthBars->RegisterHealthBar(this, HealthBarHeight, HealthBarSize);
+		UpdateHealthBar();
+	}
+	else if (!bWantsHealthBar && HealthBarHandle != INDEX_NONE)
+	{
+		HealthBars->UnregisterHealthBar(HealthBarHandle);
+	}
+}
+
+void ATurret::SetCurrentHP(float NewHP)
+{
+	CurrentHP = FMath::Clamp(NewHP, 0.0f, MaxHP);
+	UpdateHealthBar();
+}
+
+void ATurret::GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!ProjectileClass.IsNull())
 	{
-		HealthBarWidget->SetVisibility(!bIsPreviewTurret);
+		OutAssets.AddUnique(ProjectileClass.ToSoftObjectPath());
+	}
+}
+
+TSubclassOf<ASpellProjectile> ATurret::GetProjectileClass() const
+{
+	if (ProjectileClass.IsNull())
+	{
+		return nullptr;
+	}
+
+	if (UClass* Loaded = ProjectileClass.Get())
+	{
+		return Loaded;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Turret: %s wasn't preloaded, loading it now"), *ProjectileClass.ToString());
+	return ProjectileClass.LoadSynchronous();
+}
+
+void ATurret::SetProjectileClass(TSubclassOf<ASpellProjectile> NewProjectileClass)
+{
+	ProjectileClass = TSoftClassPtr<ASpellProjectile>(NewProjectileClass.Get());
+}
+
+void ATurret::UpdateHealthBar()
+{
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->SetHealthPercent(HealthBarHandle, GetHealthPercent());
 	}
 }
 
 AZombieCharacter* ATurret::FindNearestZombie()
 {
-	TArray<AActor*> FoundZombies;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AZombieCharacter::StaticClass(), FoundZombies);
+	const UZombieSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>();
+	if (!Grid)
+	{
+		return nullptr;
+	}
+
+	// Only zombies near us, collected into frame scratch memory instead of a heap array
+	FGameplayScratchScope Scratch;
+	TScratchArray<AZombieCharacter*> FoundZombies;
+	Grid->QueryRadius(GetActorLocation(), DetectionRange, FoundZombies);
 
 	AZombieCharacter* NearestZombie = nullptr;
 	float NearestDistance = DetectionRange;
 
-	for (AActor* Actor : FoundZombies)
+	for (AZombieCharacter* Zombie : FoundZombies)
 	{
-		AZombieCharacter* Zombie = Cast<AZombieCharacter>(Actor);
-		if (Zombie && !Zombie->IsDead())
+		float Distance = FVector::Dist(GetActorLocation(), Zombie->GetActorLocation());
+		if (Distance < NearestDistance)
 		{
-			float Distance = FVector::Dist(GetActorLocation(), Zombie->GetActorLocation());
-			if (Distance < NearestDistance)
-			{
-				NearestDistance = Distance;
-				NearestZombie = Zombie;
-			}
+			NearestDistance = Distance;
+			NearestZombie = Zombie;
 		}
 	}
 
@@ -199,7 +285,8 @@ AZombieCharacter* ATurret::FindNearestZombie()
 
 void ATurret::ShootAtTarget(AZombieCharacter* Target)
 {
-	if (!ProjectileClass || !Target)
+	const TSubclassOf<ASpellProjectile> SpawnClass = GetProjectileClass();
+	if (!SpawnClass || !Target)
 	{
 		return;
 	}
@@ -223,7 +310,7 @@ void ATurret::ShootAtTarget(AZombieCharacter* Target)
 	SpawnParams.Owner = this;
 	SpawnParams.Instigator = GetInstigator();
 
-	ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+	ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(SpawnClass, SpawnLocation, SpawnRotation, SpawnParams);
 
 	if (Projectile)
 	{
@@ -242,14 +329,41 @@ void ATurret::DestroyTurret()
 	bIsDestroyed = true;
 	CurrentHP = 0.0f;
 
-	if (HealthBarWidget)
-	{
-		HealthBarWidget->SetVisibility(false);
-	}
+	RefreshHealthBarRegistration();
 
 	BP_OnTurretDestroyed();
 
 	SetActorEnableCollision(false);
 	SetActorHiddenInGame(true);
-	Destroy();
+
+	// Mid-wave the nav hole stays until the build break, so zombies don't path on a rebuilding navmesh
+	if (UNavObstacleSubsystem* NavObstacles = GetWorld()->GetSubsystem<UNavObstacleSubsystem>())
+	{
+		NavObstacles->RemoveObstacle(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void ATurret::OnAttackCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// Only the capsule counts; a zombie's other colliding primitives would end their overlap while it's still in range
+	AZombieCharacter* Zombie = Cast<AZombieCharacter>(OtherActor);
+	if (Zombie && OtherComp == Zombie->GetCapsuleComponent())
+	{
+		Zombie->AddTouchingStructure(this);
+	}
+}
+
+void ATurret::OnAttackCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	AZombieCharacter* Zombie = Cast<AZombieCharacter>(OtherActor);
+	if (Zombie && OtherComp == Zombie->GetCapsuleComponent())
+	{
+		Zombie->RemoveTouchingStructure(this);
+	}
 }
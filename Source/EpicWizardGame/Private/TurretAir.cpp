@@ -1,17 +1,26 @@
 #include "TurretAir.h"
 #include "ZombieCharacter.h"
-#include "Kismet/GameplayStatics.h"
+#include "GameplayTimerSubsystem.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "GameplayScratch.h"
+#include "SimulationStepSubsystem.h"
+#include "CosmeticEffectSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
 #include "Engine/DamageEvents.h"
 
+namespace
+{
+	/** ProjectileDamage was tuned as a hit every ~60 Hz blast update; scaling by the step keeps that DPS at any simulation rate */
+	constexpr float BlastHitsPerSecond = 60.0f;
+}
+
 ATurretAir::ATurretAir()
 {
 	// Mirror airblast spell pacing and damage
 	FireRate = 1.5f;
 	ProjectileDamage = 10.0f;
 	ProjectileVerticalOffset = 80.0f;
-	AirProjectileClass = AActor::StaticClass();
+	AirProjectileClass = TSoftClassPtr<AActor>(AActor::StaticClass());
 }
 
 void ATurretAir::ShootAtTarget(AZombieCharacter* Target)
@@ -21,7 +30,7 @@ void ATurretAir::ShootAtTarget(AZombieCharacter* Target)
 		return;
 	}
 
-	if (!AirProjectileClass)
+	if (AirProjectileClass.IsNull())
 	{
 		return;
 	}
@@ -35,58 +44,108 @@ void ATurretAir::ShootAtTarget(AZombieCharacter* Target)
 	FRotator SpawnRotation = Direction.Rotation();
 	SpawnRotation.Pitch += ProjectileVisualPitchOffset; // visual-only tweak
 
-	AActor* AirblastProjectile = GetWorld()->SpawnActor<AActor>(AirProjectileClass, SpawnLocation, SpawnRotation);
-	if (!AirblastProjectile)
+	UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>();
+	USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	if (!Timers || !Simulation)
 	{
 		return;
 	}
 
-	AirblastProjectile->SetLifeSpan(ProjectileLifetime);
+	// The blast is just a point sweeping forward; only a custom projectile class gets a real actor
+	TSharedRef<FVector> BlastLocation = MakeShared<FVector>(SpawnLocation);
+	TWeakObjectPtr<AActor> WeakProjectile;
+
+	const TSubclassOf<AActor> SpawnClass = GetAirProjectileClass();
+
+	if (SpawnClass && SpawnClass != AActor::StaticClass())
+	{
+		if (AActor* AirblastProjectile = GetWorld()->SpawnActor<AActor>(SpawnClass, SpawnLocation, SpawnRotation))
+		{
+			Timers->SetActorLifeSpan(AirblastProjectile, ProjectileLifetime, EGameplayTimerCategory::AreaEffect);
+			WeakProjectile = AirblastProjectile;
+		}
+	}
+	else if (UCosmeticEffectSubsystem* Effects = GetWorld()->GetSubsystem<UCosmeticEffectSubsystem>())
+	{
+		FCosmeticEffectDesc Blast;
+		Blast.Type = ECosmeticEffectType::Airblast;
+		Blast.Location = SpawnLocation;
+		Blast.Direction = Direction;
+		Blast.Rotation = SpawnRotation;
+		Blast.Speed = ProjectileSpeed;
+		Blast.Duration = ProjectileLifetime;
+		Effects->PlayEffect(Blast);
+	}
 
 	FVector Velocity = Direction * ProjectileSpeed;
-	TWeakObjectPtr<AActor> WeakProjectile = AirblastProjectile;
 	TWeakObjectPtr<ATurretAir> WeakTurret = this;
 	const float Damage = ProjectileDamage;
 	const float Knockback = KnockbackForce;
 	const float Radius = BlastRadius;
 
-	FTimerDelegate TickDelegate;
-	TickDelegate.BindLambda([WeakProjectile, WeakTurret, Velocity, Damage, Knockback, Radius]()
+	// Every simulation step for the blast's lifetime; ends early if the turret goes away
+	Simulation->RunForDuration(ESimulationStepGroup::AreaEffects, this, ProjectileLifetime, [BlastLocation, WeakProjectile, WeakTurret, Velocity, Damage, Knockback, Radius](float StepSeconds)
 	{
-		if (!WeakProjectile.IsValid() || !WeakTurret.IsValid())
+		if (!WeakTurret.IsValid())
 		{
 			return;
 		}
 
-		AActor* Projectile = WeakProjectile.Get();
-		FVector NewLocation = Projectile->GetActorLocation() + (Velocity * 0.016f);
-		Projectile->SetActorLocation(NewLocation);
+		*BlastLocation += Velocity * StepSeconds;
+		if (AActor* Projectile = WeakProjectile.Get())
+		{
+			Projectile->SetActorLocation(*BlastLocation);
+		}
 
 		// Check for zombies to damage/knock back
-		TArray<AActor*> FoundActors;
-		UGameplayStatics::GetAllActorsOfClass(Projectile->GetWorld(), AZombieCharacter::StaticClass(), FoundActors);
+		const UZombieSpatialGridSubsystem* Grid = WeakTurret->GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>();
+		if (!Grid)
+		{
+			return;
+		}
 
-		for (AActor* Actor : FoundActors)
+		FGameplayScratchScope Scratch;
+		TScratchArray<AZombieCharacter*> FoundZombies;
+		Grid->QueryRadius(*BlastLocation, Radius, FoundZombies);
+
+		for (AZombieCharacter* Zombie : FoundZombies)
 		{
-			AZombieCharacter* Zombie = Cast<AZombieCharacter>(Actor);
-			if (!Zombie || Zombie->IsDead())
+			if (Zombie->IsDead())
 			{
 				continue;
 			}
 
-			if (FVector::Dist(Projectile->GetActorLocation(), Zombie->GetActorLocation()) <= Radius)
+			if (FVector::Dist(*BlastLocation, Zombie->GetActorLocation()) <= Radius)
 			{
 				FDamageEvent DamageEvent;
-				Zombie->TakeDamage(Damage, DamageEvent, WeakTurret->GetInstigatorController(), Projectile);
+				Zombie->TakeDamage(Damage * BlastHitsPerSecond * StepSeconds, DamageEvent, WeakTurret->GetInstigatorController(), WeakTurret.Get());
 
-				FVector KnockbackDirection = (Zombie->GetActorLocation() - Projectile->GetActorLocation()).GetSafeNormal();
+				FVector KnockbackDirection = (Zombie->GetActorLocation() - *BlastLocation).GetSafeNormal();
 				KnockbackDirection.Z = 0.0f; // match Airblast: horizontal knockback only
 				KnockbackDirection.Normalize();
 				Zombie->LaunchCharacter(KnockbackDirection * Knockback, true, true);
 			}
 		}
 	});
+}
+
+void ATurretAir::GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const
+{
+	Super::GetAssetsToPreload(OutAssets);
+
+	if (!AirProjectileClass.IsNull() && AirProjectileClass.Get() != AActor::StaticClass())
+	{
+		OutAssets.AddUnique(AirProjectileClass.ToSoftObjectPath());
+	}
+}
 
-	FTimerHandle TickTimer;
-	GetWorld()->GetTimerManager().SetTimer(TickTimer, TickDelegate, 0.016f, true);
+TSubclassOf<AActor> ATurretAir::GetAirProjectileClass() const
+{
+	// Normally preloaded for the wave; load it here if that didn't happen
+	return AirProjectileClass.LoadSynchronous();
+}
+
+void ATurretAir::SetAirProjectileClass(TSubclassOf<AActor> NewProjectileClass)
+{
+	AirProjectileClass = TSoftClassPtr<AActor>(NewProjectileClass.Get());
 }
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TurretGhost.h"
+#include "Turret.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+ATurretGhost::ATurretGhost()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent = SceneRoot;
+
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+void ATurretGhost::SetGhostMaterial(UMaterialInterface* InGhostMaterial, float InOpacity)
+{
+	GhostMaterial = InGhostMaterial;
+	GhostOpacity = InOpacity;
+}
+
+void ATurretGhost::ShowTurretClass(TSubclassOf<ATurret> TurretClass)
+{
+	if (TurretClass == CurrentClass)
+	{
+		return;
+	}
+
+	if (FTurretGhostMeshSet* OldSet = MeshSets.Find(CurrentClass))
+	{
+		for (UStaticMeshComponent* Mesh : OldSet->Meshes)
+		{
+			Mesh->SetVisibility(false);
+		}
+	}
+
+	CurrentClass = TurretClass;
+	if (!TurretClass)
+	{
+		return;
+	}
+
+	FTurretGhostMeshSet* NewSet = MeshSets.Find(TurretClass);
+	if (!NewSet)
+	{
+		NewSet = &MeshSets.Add(TurretClass);
+		BuildMeshSet(TurretClass, *NewSet);
+	}
+
+	for (UStaticMeshComponent* Mesh : NewSet->Meshes)
+	{
+		Mesh->SetVisibility(true);
+	}
+}
+
+void ATurretGhost::SetGhostVisible(bool bVisible)
+{
+	SetActorHiddenInGame(!bVisible);
+}
+
+void ATurretGhost::BuildMeshSet(TSubclassOf<ATurret> TurretClass, FTurretGhostMeshSet& OutSet)
+{
+	struct FMeshTemplate
+	{
+		const UStaticMeshComponent* Component;
+		FTransform Transform;
+	};
+	TArray<FMeshTemplate> Templates;
+
+	// Native meshes live on the class default object
+	const ATurret* TurretCDO = TurretClass->GetDefaultObject<ATurret>();
+	TArray<UStaticMeshComponent*> NativeMeshes;
+	TurretCDO->GetComponents(NativeMeshes);
+	for (const UStaticMeshComponent* Mesh : NativeMeshes)
+	{
+		Templates.Add({ Mesh, Mesh->GetRelativeTransform() });
+	}
+
+	// Blueprint-added meshes live on the construction script templates of each Blueprint class in the chain.
+	// A child Blueprint that edits an inherited one keeps its version in its inheritable component handler,
+	// so every template is resolved against the class actually being shown
+	UBlueprintGeneratedClass* ActualClass = Cast<UBlueprintGeneratedClass>(TurretClass.Get());
+	for (UBlueprintGeneratedClass* BPClass = ActualClass; BPClass; BPClass = Cast<UBlueprintGeneratedClass>(BPClass->GetSuperClass()))
+	{
+		const USimpleConstructionScript* SCS = BPClass->SimpleConstructionScript;
+		if (!SCS)
+		{
+			continue;
+		}
+
+		for (USCS_Node* Node : SCS->GetAllNodes())
+		{
+			const UStaticMeshComponent* Mesh = Node ? Cast<UStaticMeshComponent>(Node->GetActualComponentTemplate(ActualClass)) : nullptr;
+			if (!Mesh)
+			{
+				continue;
+			}
+
+			// Compose relative transforms up through Blueprint parents; native parents are treated as the root
+			FTransform Transform = Mesh->GetRelativeTransform();
+			for (USCS_Node* Parent = SCS->FindParentNode(Node); Parent; Parent = SCS->FindParentNode(Parent))
+			{
+				if (const USceneComponent* ParentTemplate = Cast<USceneComponent>(Parent->GetActualComponentTemplate(ActualClass)))
+				{
+					Transform = Transform * ParentTemplate->GetRelativeTransform();
+				}
+			}
+
+			Templates.Add({ Mesh, Transform });
+		}
+	}
+
+	for (const FMeshTemplate& Template : Templates)
+	{
+		if (!Template.Component->GetStaticMesh() || !Template.Component->IsVisible())
+		{
+			continue;
+		}
+
+		UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(this);
+		Mesh->SetStaticMesh(Template.Component->GetStaticMesh());
+		Mesh->SetupAttachment(SceneRoot);
+		Mesh->SetRelativeTransform(Template.Transform);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Mesh->SetCanEverAffectNavigation(false);
+		Mesh->SetCastShadow(false);
+		Mesh->SetVisibility(false);
+
+		for (int32 i = 0; i < Template.Component->GetNumMaterials(); i++)
+		{
+			if (UMaterialInterface* Material = GetGhostMaterial(Template.Component->GetMaterial(i)))
+			{
+				Mesh->SetMaterial(i, Material);
+			}
+		}
+
+		Mesh->RegisterComponent();
+		OutSet.Meshes.Add(Mesh);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TurretGhost: Built %d preview meshes for %s"), OutSet.Meshes.Num(), *TurretClass->GetName());
+}
+
+UMaterialInterface* ATurretGhost::GetGhostMaterial(UMaterialInterface* SourceMaterial)
+{
+	if (GhostMaterial)
+	{
+		return GhostMaterial;
+	}
+
+	if (!SourceMaterial)
+	{
+		return nullptr;
+	}
+
+	if (UMaterialInterface** Cached = MaterialCache.Find(SourceMaterial))
+	{
+		return *Cached;
+	}
+
+	UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(SourceMaterial, this);
+	DynMat->SetScalarParameterValue(FName("Opacity"), GhostOpacity);
+	MaterialCache.Add(SourceMaterial, DynMat);
+	return DynMat;
+}
@@ -2,7 +2,6 @@
 #include "ZombieCharacter.h"
 #include "SpellProjectile.h"
 #include "GameFramework/ProjectileMovementComponent.h"
-#include "UObject/ConstructorHelpers.h"
 
 ATurretIce::ATurretIce()
 {
@@ -12,16 +11,14 @@ ATurretIce::ATurretIce()
 	ProjectileAimPitchOffset = 0.0f;
 	ProjectileVisualPitchOffset = 0.0f;
 
-	static ConstructorHelpers::FClassFinder<ASpellProjectile> IceProjBP(TEXT("/Game/WizardsLastStand/Blueprints/BP_IceProjectile"));
-	if (IceProjBP.Succeeded())
-	{
-		ProjectileClass = IceProjBP.Class;
-	}
+	// Soft path only; the wave preload loads it when the turret is affordable at the start of a break, otherwise the first shot does
+	ProjectileClass = TSoftClassPtr<ASpellProjectile>(FSoftObjectPath(TEXT("/Game/WizardsLastStand/Blueprints/BP_IceProjectile.BP_IceProjectile_C")));
 }
 
 void ATurretIce::ShootAtTarget(AZombieCharacter* Target)
 {
-	if (!ProjectileClass || !Target)
+	const TSubclassOf<ASpellProjectile> SpawnClass = GetProjectileClass();
+	if (!SpawnClass || !Target)
 	{
 		return;
 	}
@@ -41,7 +38,7 @@ void ATurretIce::ShootAtTarget(AZombieCharacter* Target)
 		SpawnParams.Owner = this;
 		SpawnParams.Instigator = GetInstigator();
 
-		if (ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams))
+		if (ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(SpawnClass, SpawnLocation, SpawnRotation, SpawnParams))
 		{
 			// Speed up the ice projectile for better accuracy
 			if (UProjectileMovementComponent* MoveComp = Projectile->FindComponentByClass<UProjectileMovementComponent>())
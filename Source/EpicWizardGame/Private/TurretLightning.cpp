@@ -1,9 +1,10 @@
 #include "TurretLightning.h"
 #include "ZombieCharacter.h"
-#include "Kismet/GameplayStatics.h"
 #include "SpellProjectile.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "GameplayScratch.h"
+#include "CosmeticEffectSubsystem.h"
 #include "Engine/DamageEvents.h"
-#include "GameFramework/ProjectileMovementComponent.h"
 
 ATurretLightning::ATurretLightning()
 {
@@ -25,57 +26,40 @@ void ATurretLightning::ShootAtTarget(AZombieCharacter* Target)
 	Target->TakeDamage(ProjectileDamage, DamageEvent, GetInstigatorController(), this);
 
 	// Chain to nearby zombies
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AZombieCharacter::StaticClass(), FoundActors);
-
-	float AOEDamage = ProjectileDamage * AOEDamageMultiplier;
-	for (AActor* Actor : FoundActors)
+	if (const UZombieSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>())
 	{
-		AZombieCharacter* Zombie = Cast<AZombieCharacter>(Actor);
-		if (!Zombie || Zombie == Target || Zombie->IsDead())
-		{
-			continue;
-		}
+		FGameplayScratchScope Scratch;
+		TScratchArray<AZombieCharacter*> FoundZombies;
+		Grid->QueryRadius(StrikeLocation, AOERadius, FoundZombies);
 
-		if (FVector::Dist(Zombie->GetActorLocation(), StrikeLocation) <= AOERadius)
+		float AOEDamage = ProjectileDamage * AOEDamageMultiplier;
+		for (AZombieCharacter* Zombie : FoundZombies)
 		{
-			Zombie->TakeDamage(AOEDamage, DamageEvent, GetInstigatorController(), this);
+			if (Zombie == Target || Zombie->IsDead())
+			{
+				continue;
+			}
+
+			if (FVector::Dist(Zombie->GetActorLocation(), StrikeLocation) <= AOERadius)
+			{
+				Zombie->TakeDamage(AOEDamage, DamageEvent, GetInstigatorController(), this);
+			}
 		}
 	}
 
-	// Visual projectile
-	if (ProjectileClass)
+	// Visual-only bolt dropping onto the target; damage is already applied above
+	if (UCosmeticEffectSubsystem* Effects = GetWorld()->GetSubsystem<UCosmeticEffectSubsystem>())
 	{
-		// Spawn a visual strike above the target and send it straight down
-		FVector SpawnLocation = StrikeLocation + FVector(0.0f, 0.0f, LightningStrikeHeight);
-		FVector Direction = FVector(0.0f, 0.0f, -1.0f);
-		FRotator SpawnRotation = Direction.Rotation();
-
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Owner = this;
-		SpawnParams.Instigator = GetInstigator();
-
-		if (ASpellProjectile* Projectile = GetWorld()->SpawnActor<ASpellProjectile>(
-			ProjectileClass,
-			SpawnLocation,
-			SpawnRotation,
-			SpawnParams))
+		FCosmeticEffectDesc Bolt;
+		Bolt.Type = ECosmeticEffectType::LightningBolt;
+		Bolt.Location = StrikeLocation + FVector(0.0f, 0.0f, LightningStrikeHeight);
+		Bolt.Direction = FVector(0.0f, 0.0f, -1.0f);
+		Bolt.Speed = LightningStrikeSpeed;
+		Bolt.Duration = LightningStrikeHeight / FMath::Max(LightningStrikeSpeed, 1.0f);
+		if (const TSubclassOf<ASpellProjectile> AppearanceClass = GetProjectileClass())
 		{
-			// Push the projectile downward quickly; damage already applied above
-			if (UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>())
-			{
-				const float OriginalSpeed = Movement->InitialSpeed;
-				Movement->InitialSpeed = LightningStrikeSpeed;
-				Movement->MaxSpeed = LightningStrikeSpeed;
-				Projectile->InitializeProjectile(Direction, 0.0f);
-				// Restore configured speed in case this projectile instance is reused elsewhere
-				Movement->InitialSpeed = OriginalSpeed;
-				Movement->MaxSpeed = OriginalSpeed;
-			}
-			else
-			{
-				Projectile->InitializeProjectile(Direction, 0.0f);
-			}
+			Bolt.CopyAppearanceFrom(AppearanceClass->GetDefaultObject<ASpellProjectile>());
 		}
+		Effects->PlayEffect(Bolt);
 	}
 }
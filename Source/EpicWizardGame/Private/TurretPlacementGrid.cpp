@@ -0,0 +1,461 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TurretPlacementGrid.h"
+#include "Tower.h"
+#include "Turret.h"
+#include "ZombieSpawnGate.h"
+#include "GameplayEventBus.h"
+#include "Components/BoxComponent.h"
+#include "NavigationSystem.h"
+#include "EngineUtils.h"
+#include "DrawDebugHelpers.h"
+
+ATurretPlacementGrid::ATurretPlacementGrid()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	GridBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("GridBounds"));
+	RootComponent = GridBounds;
+	GridBounds->SetBoxExtent(FVector(2000.0f, 2000.0f, 500.0f));
+	GridBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GridBounds->SetHiddenInGame(true);
+}
+
+ATurretPlacementGrid* ATurretPlacementGrid::Find(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	for (TActorIterator<ATurretPlacementGrid> It(World); It; ++It)
+	{
+		return *It;
+	}
+
+	return nullptr;
+}
+
+void ATurretPlacementGrid::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BakeCells();
+	OccupyTowerFootprints();
+	FindGateCells();
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		TurretPlacedHandle = EventBus->OnTurretPlaced.AddUObject(this, &ATurretPlacementGrid::OnTurretPlaced);
+	}
+}
+
+void ATurretPlacementGrid::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnTurretPlaced.Remove(TurretPlacedHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATurretPlacementGrid::BakeCells()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const FVector Center = GridBounds->GetComponentLocation();
+	const FVector Extent = GridBounds->GetScaledBoxExtent();
+
+	GridOrigin = Center - Extent;
+	NumCellsX = FMath::Max(1, FMath::CeilToInt((Extent.X * 2.0f) / CellSize));
+	NumCellsY = FMath::Max(1, FMath::CeilToInt((Extent.Y * 2.0f) / CellSize));
+
+	const int32 NumCells = NumCellsX * NumCellsY;
+	CellHeights.Init(GridOrigin.Z, NumCells);
+	BuildableCells.Init(false, NumCells);
+	OccupiedCells.Init(false, NumCells);
+	WalkableCells.Init(false, NumCells);
+	TowerCells.Init(false, NumCells);
+	PathCutCells.Init(false, NumCells);
+	TurretCells.Reset();
+	bPathCutsDirty = true;
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const FVector NavExtent(CellSize * 0.5f, CellSize * 0.5f, NavHeightTolerance);
+
+	// Only static floor counts, so pawns and already placed turrets don't affect the bake
+	FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TurretGridBake), false, this);
+
+	const float TopZ = Center.Z + Extent.Z;
+	const float BottomZ = Center.Z - Extent.Z;
+
+	double HeightSum = 0.0;
+	int32 NumBuildable = 0;
+
+	for (int32 Y = 0; Y < NumCellsY; Y++)
+	{
+		for (int32 X = 0; X < NumCellsX; X++)
+		{
+			const int32 Index = Y * NumCellsX + X;
+			const float CellX = GridOrigin.X + (X + 0.5f) * CellSize;
+			const float CellY = GridOrigin.Y + (Y + 0.5f) * CellSize;
+
+			FHitResult Hit;
+			if (!World->LineTraceSingleByObjectType(Hit, FVector(CellX, CellY, TopZ), FVector(CellX, CellY, BottomZ), ObjectParams, QueryParams))
+			{
+				continue;
+			}
+
+			// Zombies have to be able to walk around turrets, so the cell must sit on the navmesh
+			if (NavSys)
+			{
+				FNavLocation NavLocation;
+				if (!NavSys->ProjectPointToNavigation(Hit.ImpactPoint, NavLocation, NavExtent))
+				{
+					continue;
+				}
+			}
+
+			CellHeights[Index] = Hit.ImpactPoint.Z;
+			WalkableCells[Index] = true;
+
+			if (Hit.ImpactNormal.Z < MinFloorNormalZ)
+			{
+				continue;
+			}
+
+			BuildableCells[Index] = true;
+			HeightSum += Hit.ImpactPoint.Z;
+			NumBuildable++;
+		}
+	}
+
+	PlaneZ = NumBuildable > 0 ? static_cast<float>(HeightSum / NumBuildable) : BottomZ;
+
+	UE_LOG(LogTemp, Log, TEXT("TurretPlacementGrid: Baked %dx%d cells, %d buildable"), NumCellsX, NumCellsY, NumBuildable);
+
+	if (bDrawDebugCells)
+	{
+		for (int32 Index = 0; Index < NumCells; Index++)
+		{
+			const FIntPoint Cell(Index % NumCellsX, Index / NumCellsX);
+			const FColor Color = BuildableCells[Index] ? FColor::Green : FColor::Red;
+			DrawDebugBox(World, GetCellLocation(Cell), FVector(CellSize * 0.45f, CellSize * 0.45f, 5.0f), Color, false, 10.0f);
+		}
+	}
+}
+
+void ATurretPlacementGrid::OccupyTowerFootprints()
+{
+	for (TActorIterator<ATower> It(GetWorld()); It; ++It)
+	{
+		// Includes the attack box so turrets never block the ring zombies attack from
+		OccupyTowerBox(It->GetComponentsBoundingBox());
+	}
+}
+
+void ATurretPlacementGrid::OccupyTowerBox(const FBox& Box)
+{
+	if (!Box.IsValid || NumCellsX == 0)
+	{
+		return;
+	}
+
+	const int32 MinX = FMath::Clamp(FMath::FloorToInt((Box.Min.X - GridOrigin.X) / CellSize), 0, NumCellsX - 1);
+	const int32 MaxX = FMath::Clamp(FMath::FloorToInt((Box.Max.X - GridOrigin.X) / CellSize), 0, NumCellsX - 1);
+	const int32 MinY = FMath::Clamp(FMath::FloorToInt((Box.Min.Y - GridOrigin.Y) / CellSize), 0, NumCellsY - 1);
+	const int32 MaxY = FMath::Clamp(FMath::FloorToInt((Box.Max.Y - GridOrigin.Y) / CellSize), 0, NumCellsY - 1);
+
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		for (int32 X = MinX; X <= MaxX; X++)
+		{
+			OccupiedCells[Y * NumCellsX + X] = true;
+			TowerCells[Y * NumCellsX + X] = true;
+		}
+	}
+}
+
+void ATurretPlacementGrid::FindGateCells()
+{
+	GateCells.Reset();
+	if (NumCellsX == 0)
+	{
+		return;
+	}
+
+	// Gates usually sit outside the buildable area, so clamp onto the grid edge and take the nearest open cell
+	const int32 SearchRadius = 3;
+
+	for (TActorIterator<AZombieSpawnGate> It(GetWorld()); It; ++It)
+	{
+		const FVector GateLocation = It->GetActorLocation();
+		const int32 GateX = FMath::Clamp(FMath::FloorToInt((GateLocation.X - GridOrigin.X) / CellSize), 0, NumCellsX - 1);
+		const int32 GateY = FMath::Clamp(FMath::FloorToInt((GateLocation.Y - GridOrigin.Y) / CellSize), 0, NumCellsY - 1);
+
+		int32 BestIndex = INDEX_NONE;
+		int32 BestDistSq = MAX_int32;
+		for (int32 DY = -SearchRadius; DY <= SearchRadius; DY++)
+		{
+			for (int32 DX = -SearchRadius; DX <= SearchRadius; DX++)
+			{
+				const int32 Index = CellToIndex(FIntPoint(GateX + DX, GateY + DY));
+				const int32 DistSq = DX * DX + DY * DY;
+				if (Index != INDEX_NONE && WalkableCells[Index] && !TowerCells[Index] && DistSq < BestDistSq)
+				{
+					BestIndex = Index;
+					BestDistSq = DistSq;
+				}
+			}
+		}
+
+		if (BestIndex != INDEX_NONE)
+		{
+			GateCells.AddUnique(BestIndex);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TurretPlacementGrid: No walkable cell near gate %s, it won't be protected from blocking"), *It->GetName());
+		}
+	}
+
+	bPathCutsDirty = true;
+}
+
+void ATurretPlacementGrid::RebuildPathCuts()
+{
+	bPathCutsDirty = false;
+
+	const int32 NumCells = NumCellsX * NumCellsY;
+	PathCutCells.Init(false, NumCells);
+	if (NumCells == 0 || GateCells.Num() == 0)
+	{
+		return;
+	}
+
+	// Graph nodes are the free walkable cells plus one virtual node for the tower, linked to every
+	// free cell bordering its footprint. A cell disconnects a gate exactly when it is an articulation
+	// point between that gate and the tower, so one Tarjan pass from the tower answers every candidate.
+	const int32 TowerNode = NumCells;
+	TArray<int32> TowerNeighbors;
+	TBitArray<> BordersTower(false, NumCells);
+	for (int32 Index = 0; Index < NumCells; Index++)
+	{
+		if (!TowerCells[Index])
+		{
+			continue;
+		}
+
+		const FIntPoint Cell(Index % NumCellsX, Index / NumCellsX);
+		for (const FIntPoint& Offset : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+		{
+			const int32 Neighbor = CellToIndex(Cell + Offset);
+			if (Neighbor != INDEX_NONE && IsCellFreeWalkable(Neighbor) && !BordersTower[Neighbor])
+			{
+				BordersTower[Neighbor] = true;
+				TowerNeighbors.Add(Neighbor);
+			}
+		}
+	}
+
+	auto GetNeighbor = [&](int32 Node, int32 EdgeIndex) -> int32
+	{
+		if (Node == TowerNode)
+		{
+			return TowerNeighbors.IsValidIndex(EdgeIndex) ? TowerNeighbors[EdgeIndex] : -2;
+		}
+
+		if (EdgeIndex >= 5)
+		{
+			return -2;
+		}
+
+		// Edge 4 links back to the tower node if this cell borders the footprint
+		if (EdgeIndex == 4)
+		{
+			return BordersTower[Node] ? TowerNode : INDEX_NONE;
+		}
+
+		static const FIntPoint Offsets[4] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+		const int32 Neighbor = CellToIndex(FIntPoint(Node % NumCellsX, Node / NumCellsX) + Offsets[EdgeIndex]);
+		return (Neighbor != INDEX_NONE && IsCellFreeWalkable(Neighbor)) ? Neighbor : INDEX_NONE;
+	};
+
+	TArray<int32> Discovery;
+	TArray<int32> Low;
+	TArray<int32> Parent;
+	Discovery.Init(INDEX_NONE, NumCells + 1);
+	Low.Init(0, NumCells + 1);
+	Parent.Init(INDEX_NONE, NumCells + 1);
+
+	// Iterative DFS, the grid can be deep enough to overflow the stack recursively.
+	// Each frame holds a node and the next edge to visit; -2 from GetNeighbor means no more edges.
+	TArray<TPair<int32, int32>> Stack;
+	int32 NextDiscovery = 0;
+	Discovery[TowerNode] = Low[TowerNode] = NextDiscovery++;
+	Stack.Emplace(TowerNode, 0);
+
+	while (Stack.Num() > 0)
+	{
+		TPair<int32, int32>& Frame = Stack.Last();
+		const int32 Node = Frame.Key;
+		const int32 Neighbor = GetNeighbor(Node, Frame.Value++);
+
+		if (Neighbor == -2)
+		{
+			Stack.Pop(EAllowShrinking::No);
+			if (Parent[Node] != INDEX_NONE)
+			{
+				Low[Parent[Node]] = FMath::Min(Low[Parent[Node]], Low[Node]);
+			}
+			continue;
+		}
+
+		if (Neighbor == INDEX_NONE || Neighbor == Parent[Node])
+		{
+			continue;
+		}
+
+		if (Discovery[Neighbor] == INDEX_NONE)
+		{
+			Parent[Neighbor] = Node;
+			Discovery[Neighbor] = Low[Neighbor] = NextDiscovery++;
+			Stack.Emplace(Neighbor, 0);
+		}
+		else
+		{
+			Low[Node] = FMath::Min(Low[Node], Discovery[Neighbor]);
+		}
+	}
+
+	// Walk each reachable gate up the DFS tree; every ancestor its subtree can't route around is a cut
+	for (const int32 GateCell : GateCells)
+	{
+		if (Discovery[GateCell] == INDEX_NONE)
+		{
+			// Already cut off (or only reachable outside the grid), nothing to protect
+			continue;
+		}
+
+		PathCutCells[GateCell] = true;
+
+		int32 Child = GateCell;
+		for (int32 Ancestor = Parent[Child]; Ancestor != TowerNode && Ancestor != INDEX_NONE; Ancestor = Parent[Ancestor])
+		{
+			if (Low[Child] >= Discovery[Ancestor])
+			{
+				PathCutCells[Ancestor] = true;
+			}
+			Child = Ancestor;
+		}
+	}
+}
+
+bool ATurretPlacementGrid::WouldBlockZombiePath(const FIntPoint& Cell)
+{
+	const int32 Index = CellToIndex(Cell);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (bPathCutsDirty)
+	{
+		RebuildPathCuts();
+	}
+
+	return PathCutCells[Index];
+}
+
+int32 ATurretPlacementGrid::CellToIndex(const FIntPoint& Cell) const
+{
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= NumCellsX || Cell.Y >= NumCellsY)
+	{
+		return INDEX_NONE;
+	}
+
+	return Cell.Y * NumCellsX + Cell.X;
+}
+
+bool ATurretPlacementGrid::WorldToCell(const FVector& WorldLocation, FIntPoint& OutCell) const
+{
+	OutCell.X = FMath::FloorToInt((WorldLocation.X - GridOrigin.X) / CellSize);
+	OutCell.Y = FMath::FloorToInt((WorldLocation.Y - GridOrigin.Y) / CellSize);
+	return CellToIndex(OutCell) != INDEX_NONE;
+}
+
+bool ATurretPlacementGrid::RayToCell(const FVector& RayOrigin, const FVector& RayDirection, FIntPoint& OutCell) const
+{
+	// Rays parallel to or pointing away from the plane never land on it
+	const float Denominator = RayDirection.Z;
+	if (FMath::IsNearlyZero(Denominator))
+	{
+		return false;
+	}
+
+	const float Distance = (PlaneZ - RayOrigin.Z) / Denominator;
+	if (Distance < 0.0f)
+	{
+		return false;
+	}
+
+	return WorldToCell(RayOrigin + RayDirection * Distance, OutCell);
+}
+
+FVector ATurretPlacementGrid::GetCellLocation(const FIntPoint& Cell) const
+{
+	const int32 Index = CellToIndex(Cell);
+	const float Z = Index != INDEX_NONE ? CellHeights[Index] : PlaneZ;
+
+	return FVector(
+		GridOrigin.X + (Cell.X + 0.5f) * CellSize,
+		GridOrigin.Y + (Cell.Y + 0.5f) * CellSize,
+		Z);
+}
+
+bool ATurretPlacementGrid::IsCellPlaceable(const FIntPoint& Cell) const
+{
+	const int32 Index = CellToIndex(Cell);
+	return Index != INDEX_NONE && BuildableCells[Index] && !OccupiedCells[Index];
+}
+
+void ATurretPlacementGrid::OccupyCell(const FIntPoint& Cell, ATurret* Turret)
+{
+	const int32 Index = CellToIndex(Cell);
+	if (Index == INDEX_NONE || !Turret)
+	{
+		return;
+	}
+
+	OccupiedCells[Index] = true;
+	TurretCells.Add(Turret, Index);
+	bPathCutsDirty = true;
+	Turret->OnDestroyed.AddUniqueDynamic(this, &ATurretPlacementGrid::OnTurretDestroyed);
+}
+
+void ATurretPlacementGrid::OnTurretPlaced(ATurret* Turret, int32 Cost)
+{
+	FIntPoint Cell;
+	if (Turret && WorldToCell(Turret->GetActorLocation(), Cell))
+	{
+		OccupyCell(Cell, Turret);
+	}
+}
+
+void ATurretPlacementGrid::OnTurretDestroyed(AActor* DestroyedActor)
+{
+	int32 Index = INDEX_NONE;
+	if (TurretCells.RemoveAndCopyValue(DestroyedActor, Index) && OccupiedCells.IsValidIndex(Index))
+	{
+		OccupiedCells[Index] = false;
+		bPathCutsDirty = true;
+	}
+}
@@ -4,16 +4,30 @@
 #include "WaveManager.h"
 #include "ZombieSpawnManager.h"
 #include "BuildModeTimerWidget.h"
+#include "GameplayEventBus.h"
+#include "GameplayRandomSubsystem.h"
+#include "NavObstacleSubsystem.h"
+#include "Tower.h"
+#include "Turret.h"
+#include "WizardCharacter.h"
+#include "WizardPlayerController.h"
+#include "HotbarWidget.h"
+#include "ZombieSpawnGate.h"
+#include "ZombieCharacter.h"
 #include "EngineUtils.h"
 #include "TimerManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Blueprint/UserWidget.h"
 
 // Sets default values
 AWaveManager::AWaveManager()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Wave flow is event driven (zombie deaths, timers), no need to tick
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 // Called when the game starts or when spawned
@@ -34,6 +48,14 @@ void AWaveManager::BeginPlay()
 	PlayerMoney = StartingMoney;
 	UE_LOG(LogTemp, Log, TEXT("WaveManager: Starting money: $%d"), PlayerMoney);
 
+	// Count kills and check for wave completion as zombies die
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		ZombieDiedHandle = EventBus->OnZombieDied.AddUObject(this, &AWaveManager::OnZombieDied);
+		RunLostHandle = EventBus->OnRunLost.AddUObject(this, &AWaveManager::OnRunLost);
+		EventBus->OnMoneyChanged.Broadcast(PlayerMoney, PlayerMoney);
+	}
+
 	// Create and add build mode timer widget to viewport
 	if (BuildModeTimerWidgetClass)
 	{
@@ -52,23 +74,53 @@ void AWaveManager::BeginPlay()
 	// Find spawn manager
 	FindSpawnManager();
 
+	bSaveWaveSnapshots |= FParse::Param(FCommandLine::Get(), TEXT("SaveWaveSnapshots"));
+
+	// Jump straight to a saved wave (e.g. a late round for benchmarking) instead of starting at round 1.
+	// Wait a tick so the tower, grid and wizard have all begun play before we restore onto them.
+	FString SnapshotPath;
+	if (SpawnManager && FParse::Value(FCommandLine::Get(), TEXT("LoadWaveSnapshot="), SnapshotPath))
+	{
+		if (FPaths::IsRelative(SnapshotPath))
+		{
+			SnapshotPath = FPaths::Combine(GetWaveSnapshotDir(), SnapshotPath);
+		}
+
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this, SnapshotPath]()
+		{
+			if (!LoadWaveSnapshotFromFile(SnapshotPath))
+			{
+				UE_LOG(LogTemp, Error, TEXT("WaveManager: Could not load wave snapshot %s, starting from round 1"), *SnapshotPath);
+				PreloadAndStartNextWave();
+			}
+		}));
+		return;
+	}
+
 	// Auto-start first wave if enabled
 	if (bAutoStartFirstWave && SpawnManager)
 	{
-		StartNextWave();
+		PreloadAndStartNextWave();
 	}
 }
 
-// Called every frame
-void AWaveManager::Tick(float DeltaTime)
+void AWaveManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnZombieDied.Remove(ZombieDiedHandle);
+		EventBus->OnRunLost.Remove(RunLostHandle);
+	}
 
-	// Check if wave is complete during active wave
-	if (bWaveActive)
+	GetWorld()->GetTimerManager().ClearTimer(BuildModeCountdownTimer);
+
+	if (WaveAssetsHandle.IsValid())
 	{
-		CheckWaveComplete();
+		WaveAssetsHandle->ReleaseHandle();
+		WaveAssetsHandle.Reset();
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AWaveManager::StartNextWave()
@@ -79,6 +131,30 @@ void AWaveManager::StartNextWave()
 		return;
 	}
 
+	// Let turret obstacles finish cutting into the navmesh so the wave doesn't hitch on tile rebuilds
+	UNavObstacleSubsystem* NavObstacles = GetWorld()->GetSubsystem<UNavObstacleSubsystem>();
+	if (bInBuildMode && NavObstacles && NavObstacles->IsRebuildPending())
+	{
+		UE_LOG(LogTemp, Log, TEXT("WaveManager: Waiting for navmesh rebuild before starting Round %d"), CurrentWave + 1);
+		GetWorld()->GetTimerManager().SetTimer(WaveBreakTimer, this, &AWaveManager::StartNextWave, NavRebuildWaitInterval, false);
+		return;
+	}
+
+	// The zombie classes and their animations are soft references; spawning before they're in would load them mid-wave
+	if (bInBuildMode && WaveAssetsHandle.IsValid() && WaveAssetsHandle->IsLoadingInProgress())
+	{
+		UE_LOG(LogTemp, Log, TEXT("WaveManager: Waiting for assets before starting Round %d"), CurrentWave + 1);
+		GetWorld()->GetTimerManager().SetTimer(WaveBreakTimer, this, &AWaveManager::StartNextWave, NavRebuildWaitInterval, false);
+		return;
+	}
+
+	// Seed this wave's spawns and remember how it started, so it can be rolled back and replayed
+	UGameplayRandomSubsystem* Random = UGameplayRandomSubsystem::Get(this);
+	const int32 WaveSeed = PendingWaveSeed.IsSet() ? PendingWaveSeed.GetValue() : (Random ? Random->NextSeed(EGameplayRandomStream::Waves) : FMath::Rand());
+	PendingWaveSeed.Reset();
+	SpawnManager->SetRandomSeed(WaveSeed);
+	CaptureWaveSnapshot(CurrentWave + 1, WaveSeed);
+
 	// Increment wave number
 	CurrentWave++;
 
@@ -89,6 +165,7 @@ void AWaveManager::StartNextWave()
 	// Set wave as active and end build mode
 	bWaveActive = true;
 	bInBuildMode = false;
+	GetWorld()->GetTimerManager().ClearTimer(BuildModeCountdownTimer);
 
 	// Update spawn manager with total zombies to spawn and health
 	SpawnManager->TotalZombiesToSpawn = TotalZombiesThisWave;
@@ -100,9 +177,14 @@ void AWaveManager::StartNextWave()
 	float ZombieHP = CalculateZombieHealth(CurrentWave);
 	UE_LOG(LogTemp, Warning, TEXT("WaveManager: Round %d started! Zombies: %d | Zombie HP: %.0f"),
 		CurrentWave, TotalZombiesThisWave, ZombieHP);
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveStarted.Broadcast(CurrentWave);
+	}
 }
 
-void AWaveManager::OnZombieDied()
+void AWaveManager::OnZombieDied(AZombieCharacter* Zombie)
 {
 	if (bWaveActive)
 	{
@@ -114,6 +196,8 @@ void AWaveManager::OnZombieDied()
 
 		UE_LOG(LogTemp, Log, TEXT("WaveManager: Zombie killed. %d/%d | +$%d (Total: $%d)"),
 			ZombiesKilledThisWave, TotalZombiesThisWave, MoneyReward, PlayerMoney);
+
+		CheckWaveComplete();
 	}
 }
 
@@ -137,8 +221,8 @@ void AWaveManager::CheckWaveComplete()
 		return;
 	}
 
-	// Wave is complete when all zombies are killed
-	if (ZombiesKilledThisWave >= TotalZombiesThisWave && SpawnManager->GetTotalZombieCount() == 0)
+	// Wave is complete when all zombies are killed (the zombie that just died is already flagged dead)
+	if (ZombiesKilledThisWave >= TotalZombiesThisWave && SpawnManager->GetAliveZombieCount() == 0)
 	{
 		OnWaveComplete();
 	}
@@ -168,6 +252,11 @@ void AWaveManager::OnWaveComplete()
 
 	UE_LOG(LogTemp, Warning, TEXT("WaveManager: Round %d complete! Starting break..."), CurrentWave);
 
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveCompleted.Broadcast(CurrentWave);
+	}
+
 	// Start wave break
 	StartWaveBreak();
 }
@@ -194,12 +283,340 @@ void AWaveManager::StartWaveBreak()
 		}
 	}
 
+	// Use the break to get the next wave's assets in memory before anything needs them
+	PreloadNextWaveAssets();
+
 	// Start timer for next wave
 	GetWorld()->GetTimerManager().SetTimer(WaveBreakTimer, this, &AWaveManager::StartNextWave, TimeBetweenWaves, false);
 
+	// Countdown events land whenever the displayed whole second changes
+	BroadcastBuildModeSecond();
+	const float FirstSecondDelay = FMath::Frac(TimeBetweenWaves) > KINDA_SMALL_NUMBER ? FMath::Frac(TimeBetweenWaves) : 1.0f;
+	GetWorld()->GetTimerManager().SetTimer(BuildModeCountdownTimer, this, &AWaveManager::BroadcastBuildModeSecond, 1.0f, true, FirstSecondDelay);
+
 	UE_LOG(LogTemp, Warning, TEXT("WaveManager: BUILD MODE STARTED - %.0f seconds until Round %d"), TimeBetweenWaves, CurrentWave + 1);
 }
 
+void AWaveManager::PreloadNextWaveAssets()
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+
+	// Zombie classes not in memory yet; their animations are only known once they are
+	TArray<TSoftClassPtr<AZombieCharacter>> UnloadedZombieClasses;
+
+	// Zombies from every gate
+	if (SpawnManager)
+	{
+		for (const AZombieSpawnGate* Gate : SpawnManager->GetSpawnGates())
+		{
+			if (!Gate || Gate->GetZombieClass().IsNull())
+			{
+				continue;
+			}
+
+			AssetsToLoad.AddUnique(Gate->GetZombieClass().ToSoftObjectPath());
+
+			if (const UClass* ZombieClass = Gate->GetZombieClass().Get())
+			{
+				ZombieClass->GetDefaultObject<AZombieCharacter>()->GetAssetsToPreload(AssetsToLoad);
+			}
+			else
+			{
+				UnloadedZombieClasses.AddUnique(Gate->GetZombieClass());
+			}
+		}
+	}
+
+	// Turrets the player can afford right now, and whatever they shoot
+	const AWizardPlayerController* PC = Cast<AWizardPlayerController>(UGameplayStatics::GetPlayerController(this, 0));
+	if (const UHotbarWidget* Hotbar = PC ? PC->GetHotbarWidget() : nullptr)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Hotbar->NumSlots; SlotIndex++)
+		{
+			const TSubclassOf<ATurret> TurretClass = Hotbar->GetTurretInSlot(SlotIndex);
+			if (TurretClass && Hotbar->GetTurretCost(SlotIndex) <= PlayerMoney)
+			{
+				AssetsToLoad.AddUnique(FSoftObjectPath(TurretClass.Get()));
+				TurretClass->GetDefaultObject<ATurret>()->GetAssetsToPreload(AssetsToLoad);
+			}
+		}
+	}
+
+	if (BuildModeTimerWidgetClass)
+	{
+		AssetsToLoad.AddUnique(FSoftObjectPath(BuildModeTimerWidgetClass.Get()));
+	}
+
+	// Request the new set before dropping the old one so shared assets stay resident
+	TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(WaveAssetsHandle);
+
+	if (AssetsToLoad.Num() > 0)
+	{
+		const double RequestTime = FPlatformTime::Seconds();
+		const int32 NumAssets = AssetsToLoad.Num();
+		const int32 NextWave = CurrentWave + 1;
+		WaveAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetsToLoad),
+			FStreamableDelegate::CreateWeakLambda(this, [this, RequestTime, NumAssets, NextWave, UnloadedZombieClasses]()
+			{
+				UE_LOG(LogTemp, Log, TEXT("WaveManager: %d assets for Round %d loaded in %.1fms"),
+					NumAssets, NextWave, (FPlatformTime::Seconds() - RequestTime) * 1000.0);
+
+				// A zombie class came in cold; go again so its animations load before the wave too
+				for (const TSoftClassPtr<AZombieCharacter>& ZombieClass : UnloadedZombieClasses)
+				{
+					if (ZombieClass.Get())
+					{
+						PreloadNextWaveAssets();
+						break;
+					}
+				}
+			}),
+			FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->ReleaseHandle();
+	}
+}
+
+void AWaveManager::PreloadAndStartNextWave()
+{
+	PreloadNextWaveAssets();
+
+	// StartNextWave only holds the wave while in build mode
+	bInBuildMode = true;
+	StartNextWave();
+}
+
+void AWaveManager::OnRunLost()
+{
+	if (bRunLost)
+	{
+		return;
+	}
+
+	bRunLost = true;
+	bWaveActive = false;
+	bInBuildMode = false;
+	GetWorld()->GetTimerManager().ClearTimer(WaveBreakTimer);
+	GetWorld()->GetTimerManager().ClearTimer(BuildModeCountdownTimer);
+
+	if (SpawnManager)
+	{
+		SpawnManager->StopSpawning();
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("WaveManager: Run lost on Round %d"), CurrentWave);
+}
+
+void AWaveManager::ClearRunWorld()
+{
+	UWorld* World = GetWorld();
+
+	bRunLost = false;
+	bWaveActive = false;
+	bInBuildMode = false;
+	World->GetTimerManager().ClearTimer(WaveBreakTimer);
+	World->GetTimerManager().ClearTimer(BuildModeCountdownTimer);
+
+	if (SpawnManager)
+	{
+		SpawnManager->DespawnAllZombies();
+	}
+
+	// Turrets free their grid cells and nav obstacles as they go
+	for (TActorIterator<ATurret> It(World); It; ++It)
+	{
+		It->Destroy();
+	}
+
+	for (TActorIterator<AWizardCharacter> It(World); It; ++It)
+	{
+		It->ResetForRestart();
+	}
+
+	TotalZombiesThisWave = 0;
+	ZombiesKilledThisWave = 0;
+}
+
+void AWaveManager::RestartRun()
+{
+	const double RestartStartTime = FPlatformTime::Seconds();
+
+	ClearRunWorld();
+
+	for (TActorIterator<ATower> It(GetWorld()); It; ++It)
+	{
+		It->ResetTower();
+	}
+
+	CurrentWave = 0;
+	PendingWaveSeed.Reset();
+	bHasWaveStartSnapshot = false;
+
+	const int32 Delta = StartingMoney - PlayerMoney;
+	PlayerMoney = StartingMoney;
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnMoneyChanged.Broadcast(PlayerMoney, Delta);
+		EventBus->OnRunRestarted.Broadcast();
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("WaveManager: Run restarted in place in %.2fms"), (FPlatformTime::Seconds() - RestartStartTime) * 1000.0);
+
+	// Hold the first wave until its assets are in and the removed turrets are cut back out of the navmesh
+	if (bAutoStartFirstWave && SpawnManager)
+	{
+		PreloadAndStartNextWave();
+	}
+}
+
+void AWaveManager::CaptureWaveSnapshot(int32 Wave, int32 SpawnSeed)
+{
+	UWorld* World = GetWorld();
+
+	WaveStartSnapshot.Wave = Wave;
+	WaveStartSnapshot.PlayerMoney = PlayerMoney;
+	WaveStartSnapshot.SpawnSeed = SpawnSeed;
+	WaveStartSnapshot.TowerHP = 0.0f;
+	for (TActorIterator<ATower> It(World); It; ++It)
+	{
+		WaveStartSnapshot.TowerHP = It->GetCurrentHP();
+		break;
+	}
+
+	WaveStartSnapshot.Turrets.Reset();
+	for (TActorIterator<ATurret> It(World); It; ++It)
+	{
+		if (It->IsPreviewTurret() || It->IsDestroyed())
+		{
+			continue;
+		}
+
+		FTurretSnapshot& Turret = WaveStartSnapshot.Turrets.AddDefaulted_GetRef();
+		Turret.ClassPath = It->GetClass()->GetPathName();
+		Turret.Transform = It->GetActorTransform();
+		Turret.CurrentHP = It->GetCurrentHP();
+	}
+
+	bHasWaveStartSnapshot = true;
+
+	if (bSaveWaveSnapshots)
+	{
+		const FString FilePath = FPaths::Combine(GetWaveSnapshotDir(), FString::Printf(TEXT("Wave_%02d.wsnap"), Wave));
+		if (!WaveStartSnapshot.SaveToFile(FilePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WaveManager: Failed to save wave snapshot to %s"), *FilePath);
+		}
+	}
+}
+
+bool AWaveManager::RollbackToWaveStart()
+{
+	if (!bHasWaveStartSnapshot)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaveManager: No wave start snapshot to roll back to"));
+		return false;
+	}
+
+	// Copy, applying overwrites WaveStartSnapshot when the wave restarts
+	const FWaveSnapshot Snapshot = WaveStartSnapshot;
+	ApplyWaveSnapshot(Snapshot);
+	return true;
+}
+
+void AWaveManager::ApplyWaveSnapshot(const FWaveSnapshot& Snapshot)
+{
+	const double RollbackStartTime = FPlatformTime::Seconds();
+	UWorld* World = GetWorld();
+
+	ClearRunWorld();
+
+	for (TActorIterator<ATower> It(World); It; ++It)
+	{
+		It->SetCurrentHP(Snapshot.TowerHP);
+	}
+
+	UGameplayEventBus* EventBus = UGameplayEventBus::Get(this);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (const FTurretSnapshot& TurretSnapshot : Snapshot.Turrets)
+	{
+		UClass* TurretClass = FSoftClassPath(TurretSnapshot.ClassPath).TryLoadClass<ATurret>();
+		if (!TurretClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WaveManager: Snapshot turret class %s not found, skipping"), *TurretSnapshot.ClassPath);
+			continue;
+		}
+
+		ATurret* Turret = World->SpawnActor<ATurret>(TurretClass, TurretSnapshot.Transform, SpawnParams);
+		if (Turret)
+		{
+			Turret->SetCurrentHP(TurretSnapshot.CurrentHP);
+
+			// Free placement, so the grid occupies the cell without anyone charging for it
+			if (EventBus)
+			{
+				EventBus->OnTurretPlaced.Broadcast(Turret, 0);
+			}
+		}
+	}
+
+	// StartNextWave advances to the snapshot's wave with its spawn seed
+	CurrentWave = Snapshot.Wave - 1;
+	PendingWaveSeed = Snapshot.SpawnSeed;
+
+	const int32 Delta = Snapshot.PlayerMoney - PlayerMoney;
+	PlayerMoney = Snapshot.PlayerMoney;
+
+	if (EventBus)
+	{
+		EventBus->OnMoneyChanged.Broadcast(PlayerMoney, Delta);
+		EventBus->OnRunRestarted.Broadcast();
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("WaveManager: Restored start of Round %d (%d turrets, $%d) in %.2fms"),
+		Snapshot.Wave, Snapshot.Turrets.Num(), PlayerMoney, (FPlatformTime::Seconds() - RollbackStartTime) * 1000.0);
+
+	// Hold the wave until its assets are in and the restored turrets are cut into the navmesh
+	PreloadAndStartNextWave();
+}
+
+bool AWaveManager::LoadWaveSnapshotFromFile(const FString& FilePath)
+{
+	FWaveSnapshot Snapshot;
+	if (!Snapshot.LoadFromFile(FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaveManager: %s is missing or not a valid wave snapshot"), *FilePath);
+		return false;
+	}
+
+	ApplyWaveSnapshot(Snapshot);
+	return true;
+}
+
+FString AWaveManager::GetWaveSnapshotDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WaveSnapshots"));
+}
+
+void AWaveManager::BroadcastBuildModeSecond()
+{
+	if (!bInBuildMode)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(BuildModeCountdownTimer);
+		return;
+	}
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnBuildModeSecondElapsed.Broadcast(FMath::CeilToInt(GetBuildModeTimeRemaining()));
+	}
+}
+
 float AWaveManager::CalculateZombieHealth(int32 RoundNumber) const
 {
 	if (RoundNumber <= 0)
@@ -265,6 +682,11 @@ int32 AWaveManager::CalculateMoneyReward() const
 void AWaveManager::AddMoney(int32 Amount)
 {
 	PlayerMoney += Amount;
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnMoneyChanged.Broadcast(PlayerMoney, Amount);
+	}
 }
 
 bool AWaveManager::SpendMoney(int32 Amount)
@@ -273,6 +695,11 @@ bool AWaveManager::SpendMoney(int32 Amount)
 	{
 		PlayerMoney -= Amount;
 		UE_LOG(LogTemp, Log, TEXT("WaveManager: Spent $%d. Remaining: $%d"), Amount, PlayerMoney);
+
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			EventBus->OnMoneyChanged.Broadcast(PlayerMoney, -Amount);
+		}
 		return true;
 	}
 
@@ -0,0 +1,586 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveSimulationSubsystem.h"
+#include "WaveManager.h"
+#include "Turret.h"
+#include "Tower.h"
+#include "TurretPlacementGrid.h"
+#include "ZombieCharacter.h"
+#include "WizardPlayerController.h"
+#include "HotbarWidget.h"
+#include "GameplayEventBus.h"
+#include "GameplayRandomSubsystem.h"
+#include "SimulationStepSubsystem.h"
+#include "NavigationSystem.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** How many cells out from the tower the build policy looks for a free one */
+	constexpr int32 MaxBuildRadius = 32;
+
+	/** Without a grid: distance between turrets and between rings, a turret's footprint plus a walkway */
+	constexpr float RingBuildSpacing = 450.0f;
+
+	/** Without a grid: radius of the first ring, clear of the tower */
+	constexpr float FirstRingRadius = 600.0f;
+
+	/** Without a grid: rings tried before giving up */
+	constexpr int32 MaxBuildRings = 12;
+
+	/** How far off the navmesh a ring point may be and still be projected onto it */
+	const FVector RingProjectionExtent(200.0f, 200.0f, 500.0f);
+}
+
+void UWaveSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Runs off the simulation step and the event bus, and reports the run seed
+	Collection.InitializeDependency<UGameplayRandomSubsystem>();
+	Collection.InitializeDependency<USimulationStepSubsystem>();
+	Collection.InitializeDependency<UGameplayEventBus>();
+}
+
+bool UWaveSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWaveSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FString CurrentLevelName = InWorld.GetMapName();
+	CurrentLevelName.RemoveFromStart(InWorld.StreamingLevelsPrefix);
+	if (CurrentLevelName.Contains(TEXT("TitleScreen")) || CurrentLevelName.Contains(TEXT("DeathScreen")))
+	{
+		return;
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("WaveSim")))
+	{
+		StartSimulation();
+	}
+}
+
+void UWaveSimulationSubsystem::Deinitialize()
+{
+	// The world went away first (a level change); still report what we have
+	if (bRunning)
+	{
+		bRunning = false;
+		WriteReports(TEXT("world ended"));
+	}
+
+	RestoreFixedTimeStep();
+
+	if (USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>())
+	{
+		Simulation->OnStep(ESimulationStepGroup::Other).Remove(StepHandle);
+	}
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnWaveStarted.Remove(WaveStartedHandle);
+		EventBus->OnWaveCompleted.Remove(WaveCompletedHandle);
+		EventBus->OnBuildModeSecondElapsed.Remove(BuildModeSecondHandle);
+		EventBus->OnZombieDied.Remove(ZombieDiedHandle);
+		EventBus->OnRunLost.Remove(RunLostHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+FString UWaveSimulationSubsystem::GetReportDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WaveSim"));
+}
+
+void UWaveSimulationSubsystem::StartSimulation()
+{
+	USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	UGameplayEventBus* EventBus = UGameplayEventBus::Get(this);
+	if (!Simulation || !EventBus)
+	{
+		return;
+	}
+
+	FParse::Value(FCommandLine::Get(), TEXT("WaveSimMaxWave="), MaxWave);
+	FParse::Value(FCommandLine::Get(), TEXT("WaveSimWaveTimeout="), WaveTimeout);
+	bExitWhenDone = !FParse::Param(FCommandLine::Get(), TEXT("WaveSimNoExit"));
+
+	FString SlotList;
+	if (FParse::Value(FCommandLine::Get(), TEXT("WaveSimSlots="), SlotList))
+	{
+		TArray<FString> SlotStrings;
+		SlotList.ParseIntoArray(SlotStrings, TEXT(","));
+		for (const FString& SlotString : SlotStrings)
+		{
+			AllowedSlots.Add(FCString::Atoi(*SlotString));
+		}
+	}
+
+	bRunning = true;
+	RealStartTime = FPlatformTime::Seconds();
+	ReportName = FString::Printf(TEXT("WaveSim_%s"), *FDateTime::Now().ToString());
+
+	// One simulation step per frame with nothing waiting on the clock, so the run goes as fast as the CPU allows.
+	// The target rate, since the current one may already be throttled by a slow first frame
+	bPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+	bOverrodeFixedTimeStep = true;
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / Simulation->GetTargetStepRate());
+
+	StepHandle = Simulation->OnStep(ESimulationStepGroup::Other).AddUObject(this, &UWaveSimulationSubsystem::SimulationStep);
+	WaveStartedHandle = EventBus->OnWaveStarted.AddUObject(this, &UWaveSimulationSubsystem::OnWaveStarted);
+	WaveCompletedHandle = EventBus->OnWaveCompleted.AddUObject(this, &UWaveSimulationSubsystem::OnWaveCompleted);
+	BuildModeSecondHandle = EventBus->OnBuildModeSecondElapsed.AddUObject(this, &UWaveSimulationSubsystem::OnBuildModeSecondElapsed);
+	ZombieDiedHandle = EventBus->OnZombieDied.AddUObject(this, &UWaveSimulationSubsystem::OnZombieDied);
+	RunLostHandle = EventBus->OnRunLost.AddUObject(this, &UWaveSimulationSubsystem::OnRunLost);
+
+	UE_LOG(LogTemp, Warning, TEXT("WaveSim: Simulating up to Round %d at %.1f Hz"), MaxWave, Simulation->GetTargetStepRate());
+}
+
+void UWaveSimulationSubsystem::FinishSimulation(const TCHAR* Reason)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	WriteReports(Reason);
+	RestoreFixedTimeStep();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("WaveSim"));
+	}
+}
+
+void UWaveSimulationSubsystem::RestoreFixedTimeStep()
+{
+	if (!bOverrodeFixedTimeStep)
+	{
+		return;
+	}
+
+	FApp::SetUseFixedTimeStep(bPrevUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PrevFixedDeltaTime);
+	bOverrodeFixedTimeStep = false;
+}
+
+void UWaveSimulationSubsystem::SimulationStep(float StepSeconds)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	// Only the defences are being measured, so take the wizard out once it has spawned
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (APawn* Wizard = PC ? PC->GetPawn() : nullptr)
+	{
+		// The hotbar belongs to the player, grab the turret list while it's certainly around
+		GatherBuildOptions();
+
+		PC->UnPossess();
+		Wizard->Destroy();
+		UE_LOG(LogTemp, Log, TEXT("WaveSim: Removed the wizard"));
+	}
+
+	const AWaveManager* WaveManager = GetWaveManager();
+	if (WaveManager && WaveManager->IsWaveActive() && Rounds.Num() > 0)
+	{
+		const double WaveTime = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetSimulationTime() - Rounds.Last().StartTime;
+		if (WaveTime > WaveTimeout)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WaveSim: Round %d still running after %.0fs with %d zombies left"),
+				WaveManager->GetCurrentWave(), WaveTime, WaveManager->GetZombiesRemainingThisWave());
+			FinishSimulation(TEXT("wave stalled"));
+		}
+	}
+}
+
+bool UWaveSimulationSubsystem::GatherBuildOptions()
+{
+	if (BuildOptions.Num() > 0)
+	{
+		return true;
+	}
+
+	const AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetWorld()->GetFirstPlayerController());
+	const UHotbarWidget* Hotbar = PC ? PC->GetHotbarWidget() : nullptr;
+	if (!Hotbar)
+	{
+		return false;
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < Hotbar->NumSlots; SlotIndex++)
+	{
+		const TSubclassOf<ATurret> TurretClass = Hotbar->GetTurretInSlot(SlotIndex);
+		if (!TurretClass || (AllowedSlots.Num() > 0 && !AllowedSlots.Contains(SlotIndex)))
+		{
+			continue;
+		}
+
+		FBuildOption& Option = BuildOptions.AddDefaulted_GetRef();
+		Option.TurretClass = TurretClass;
+		Option.Cost = Hotbar->GetTurretCost(SlotIndex);
+
+		UE_LOG(LogTemp, Log, TEXT("WaveSim: Building %s for $%d"), *GetTurretTypeName(TurretClass), Option.Cost);
+	}
+
+	return BuildOptions.Num() > 0;
+}
+
+void UWaveSimulationSubsystem::BuildTurrets()
+{
+	AWaveManager* WaveManager = GetWaveManager();
+	if (!WaveManager || !GatherBuildOptions())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaveSim: No turrets on the hotbar to build"));
+		return;
+	}
+
+	UGameplayEventBus* EventBus = UGameplayEventBus::Get(this);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// Buy in a fixed rotation and save up when the next one is too expensive, so every type gets built
+	while (true)
+	{
+		const FBuildOption& Option = BuildOptions[NextBuildOption];
+		if (WaveManager->GetPlayerMoney() < Option.Cost)
+		{
+			return;
+		}
+
+		FVector Location;
+		if (!FindBuildLocation(Location))
+		{
+			UE_LOG(LogTemp, Log, TEXT("WaveSim: No free %s left near the tower"),
+				GetPlacementGrid() ? TEXT("grid cell") : TEXT("spot on the rings"));
+			return;
+		}
+
+		if (!WaveManager->SpendMoney(Option.Cost))
+		{
+			return;
+		}
+
+		ATurret* Turret = GetWorld()->SpawnActor<ATurret>(Option.TurretClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Turret)
+		{
+			// Don't keep paying for a class that won't spawn
+			WaveManager->AddMoney(Option.Cost);
+			return;
+		}
+
+		// The grid occupies the cell from here, so the next search moves on
+		if (EventBus)
+		{
+			EventBus->OnTurretPlaced.Broadcast(Turret, Option.Cost);
+		}
+
+		PendingMoneySpent += Option.Cost;
+		TurretsBuiltByType.FindOrAdd(GetTurretTypeName(Option.TurretClass))++;
+		NextBuildOption = (NextBuildOption + 1) % BuildOptions.Num();
+	}
+}
+
+ATurretPlacementGrid* UWaveSimulationSubsystem::GetPlacementGrid()
+{
+	if (!bLookedUpPlacementGrid)
+	{
+		bLookedUpPlacementGrid = true;
+		CachedPlacementGrid = ATurretPlacementGrid::Find(this);
+		if (!CachedPlacementGrid.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WaveSim: No TurretPlacementGrid in this level, placing turrets on rings around the tower instead"));
+		}
+	}
+
+	return CachedPlacementGrid.Get();
+}
+
+bool UWaveSimulationSubsystem::FindBuildLocation(FVector& OutLocation)
+{
+	const ATower* Tower = nullptr;
+	for (TActorIterator<ATower> It(GetWorld()); It; ++It)
+	{
+		Tower = *It;
+		break;
+	}
+
+	if (!Tower)
+	{
+		return false;
+	}
+
+	if (ATurretPlacementGrid* Grid = GetPlacementGrid())
+	{
+		return FindGridBuildLocation(Grid, Tower->GetActorLocation(), OutLocation);
+	}
+
+	return FindRingBuildLocation(Tower->GetActorLocation(), OutLocation);
+}
+
+bool UWaveSimulationSubsystem::FindGridBuildLocation(ATurretPlacementGrid* Grid, const FVector& TowerLocation, FVector& OutLocation) const
+{
+	FIntPoint TowerCell;
+	if (!Grid->WorldToCell(TowerLocation, TowerCell))
+	{
+		return false;
+	}
+
+	// Ring by ring outwards, in a fixed order so the layout is the same every run
+	for (int32 Radius = 1; Radius <= MaxBuildRadius; Radius++)
+	{
+		for (int32 Y = -Radius; Y <= Radius; Y++)
+		{
+			for (int32 X = -Radius; X <= Radius; X++)
+			{
+				if (FMath::Max(FMath::Abs(X), FMath::Abs(Y)) != Radius)
+				{
+					continue;
+				}
+
+				const FIntPoint Cell = TowerCell + FIntPoint(X, Y);
+				if (Grid->IsCellPlaceable(Cell) && !Grid->WouldBlockZombiePath(Cell))
+				{
+					OutLocation = Grid->GetCellLocation(Cell);
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+bool UWaveSimulationSubsystem::FindRingBuildLocation(const FVector& TowerLocation, FVector& OutLocation) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	TArray<FVector> TurretLocations;
+	for (TActorIterator<ATurret> It(GetWorld()); It; ++It)
+	{
+		if (!It->IsDestroyed() && !It->IsPreviewTurret())
+		{
+			TurretLocations.Add(It->GetActorLocation());
+		}
+	}
+
+	// Ring by ring outwards, each walked from the same angle so the layout is the same every run
+	for (int32 Ring = 0; Ring < MaxBuildRings; Ring++)
+	{
+		const float Radius = FirstRingRadius + Ring * RingBuildSpacing;
+		const int32 NumPoints = FMath::Max(FMath::FloorToInt32(2.0f * PI * Radius / RingBuildSpacing), 1);
+
+		for (int32 PointIndex = 0; PointIndex < NumPoints; PointIndex++)
+		{
+			const float Angle = 2.0f * PI * PointIndex / NumPoints;
+			const FVector Point = TowerLocation + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius;
+
+			FNavLocation Projected;
+			if (!NavSys->ProjectPointToNavigation(Point, Projected, RingProjectionExtent))
+			{
+				continue;
+			}
+
+			const bool bCrowded = TurretLocations.ContainsByPredicate([&Projected](const FVector& TurretLocation)
+			{
+				return FVector::DistSquared2D(TurretLocation, Projected.Location) < FMath::Square(RingBuildSpacing);
+			});
+
+			if (!bCrowded)
+			{
+				OutLocation = Projected.Location;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+FString UWaveSimulationSubsystem::GetTurretTypeName(const UClass* TurretClass)
+{
+	FString Name = GetNameSafe(TurretClass);
+	Name.RemoveFromEnd(TEXT("_C"));
+	return Name;
+}
+
+AWaveManager* UWaveSimulationSubsystem::GetWaveManager() const
+{
+	if (!CachedWaveManager.IsValid())
+	{
+		for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
+		{
+			CachedWaveManager = *It;
+			break;
+		}
+	}
+
+	return CachedWaveManager.Get();
+}
+
+void UWaveSimulationSubsystem::OnWaveStarted(int32 Wave)
+{
+	const AWaveManager* WaveManager = GetWaveManager();
+	if (!bRunning || !WaveManager)
+	{
+		return;
+	}
+
+	bBuiltThisBreak = false;
+
+	FWaveSimRound& Round = Rounds.AddDefaulted_GetRef();
+	Round.Wave = Wave;
+	Round.StartTime = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetSimulationTime();
+	Round.Zombies = WaveManager->GetTotalZombiesThisWave();
+	Round.ZombieHealth = WaveManager->CalculateZombieHealth(Wave);
+	Round.MoneyAtStart = WaveManager->GetPlayerMoney();
+	Round.MoneySpent = PendingMoneySpent;
+	PendingMoneySpent = 0;
+
+	for (TActorIterator<ATurret> It(GetWorld()); It; ++It)
+	{
+		if (!It->IsPreviewTurret() && !It->IsDestroyed())
+		{
+			Round.TurretsAlive++;
+		}
+	}
+
+	for (TActorIterator<ATower> It(GetWorld()); It; ++It)
+	{
+		Round.TowerHP = It->GetCurrentHP();
+		break;
+	}
+}
+
+void UWaveSimulationSubsystem::OnWaveCompleted(int32 Wave)
+{
+	const AWaveManager* WaveManager = GetWaveManager();
+	if (!bRunning || !WaveManager || Rounds.Num() == 0)
+	{
+		return;
+	}
+
+	FWaveSimRound& Round = Rounds.Last();
+	Round.Duration = GetWorld()->GetSubsystem<USimulationStepSubsystem>()->GetSimulationTime() - Round.StartTime;
+	Round.MoneyEarned = WaveManager->GetPlayerMoney() - Round.MoneyAtStart;
+	WavesCleared = Wave;
+
+	UE_LOG(LogTemp, Log, TEXT("WaveSim: Round %d cleared in %.1fs simulated, $%d"), Wave, Round.Duration, WaveManager->GetPlayerMoney());
+
+	if (Wave >= MaxWave)
+	{
+		FinishSimulation(TEXT("reached the last wave"));
+	}
+}
+
+void UWaveSimulationSubsystem::OnBuildModeSecondElapsed(int32 SecondsRemaining)
+{
+	// Build once at the start of each break
+	if (!bRunning || bBuiltThisBreak)
+	{
+		return;
+	}
+
+	bBuiltThisBreak = true;
+	BuildTurrets();
+}
+
+void UWaveSimulationSubsystem::OnZombieDied(AZombieCharacter* Zombie)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	// Turrets hit directly (lightning, air) or through projectiles they own
+	const AActor* Causer = Zombie->GetLastDamageCauser();
+	const ATurret* Turret = Cast<ATurret>(Causer);
+	if (!Turret && Causer)
+	{
+		Turret = Cast<ATurret>(Causer->GetOwner());
+	}
+
+	KillsByType.FindOrAdd(Turret ? GetTurretTypeName(Turret->GetClass()) : TEXT("Other"))++;
+}
+
+void UWaveSimulationSubsystem::OnRunLost()
+{
+	FinishSimulation(TEXT("run lost"));
+}
+
+bool UWaveSimulationSubsystem::WriteReports(const TCHAR* Reason) const
+{
+	const USimulationStepSubsystem* Simulation = GetWorld()->GetSubsystem<USimulationStepSubsystem>();
+	const UGameplayRandomSubsystem* Random = GetWorld()->GetSubsystem<UGameplayRandomSubsystem>();
+	const double SimSeconds = Simulation ? Simulation->GetSimulationTime() : 0.0;
+	const double RealSeconds = FPlatformTime::Seconds() - RealStartTime;
+
+	// Money curve, one row per wave
+	FString Csv = TEXT("Wave,StartTime,Duration,Zombies,ZombieHealth,MoneyAtStart,MoneyEarned,MoneySpent,TurretsAlive,TowerHP\n");
+	for (const FWaveSimRound& Round : Rounds)
+	{
+		Csv += FString::Printf(TEXT("%d,%.2f,%.2f,%d,%.0f,%d,%d,%d,%d,%.0f\n"), Round.Wave, Round.StartTime, Round.Duration,
+			Round.Zombies, Round.ZombieHealth, Round.MoneyAtStart, Round.MoneyEarned, Round.MoneySpent, Round.TurretsAlive, Round.TowerHP);
+	}
+
+	FString Summary;
+	Summary += FString::Printf(TEXT("Wave simulation on %s: %s\n"), *GetWorld()->GetMapName(), Reason);
+	Summary += FString::Printf(TEXT("Seed: %d\n"), Random ? Random->GetRunSeed() : 0);
+	Summary += FString::Printf(TEXT("Step rate: %.1f Hz\n"), Simulation ? Simulation->GetTargetStepRate() : 0.0f);
+	Summary += FString::Printf(TEXT("Rounds survived: %d\n"), WavesCleared);
+	Summary += FString::Printf(TEXT("Simulated %.1fs in %.1fs real (%.1f simulated seconds per real second)\n"),
+		SimSeconds, RealSeconds, RealSeconds > 0.0 ? SimSeconds / RealSeconds : 0.0);
+
+	Summary += TEXT("Turrets built:\n");
+	for (const TPair<FString, int32>& Built : TurretsBuiltByType)
+	{
+		Summary += FString::Printf(TEXT("  %s: %d\n"), *Built.Key, Built.Value);
+	}
+
+	Summary += TEXT("Kills:\n");
+	for (const TPair<FString, int32>& Kills : KillsByType)
+	{
+		Summary += FString::Printf(TEXT("  %s: %d\n"), *Kills.Key, Kills.Value);
+	}
+
+	const FString CsvPath = FPaths::Combine(GetReportDir(), ReportName + TEXT(".csv"));
+	const FString SummaryPath = FPaths::Combine(GetReportDir(), ReportName + TEXT(".txt"));
+	const bool bWritten = FFileHelper::SaveStringToFile(Csv, *CsvPath) && FFileHelper::SaveStringToFile(Summary, *SummaryPath);
+
+	TArray<FString> SummaryLines;
+	Summary.ParseIntoArrayLines(SummaryLines);
+	for (const FString& Line : SummaryLines)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaveSim: %s"), *Line);
+	}
+
+	if (!bWritten)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("WaveSim: Failed to write reports to %s"), *GetReportDir());
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("WaveSim: Reports written to %s"), *SummaryPath);
+	return true;
+}
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveSnapshot.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	/** "WSNP" */
+	constexpr uint32 WaveSnapshotMagic = 0x504E5357;
+}
+
+void FWaveSnapshot::Serialize(FArchive& Ar)
+{
+	Ar << Wave << PlayerMoney << TowerHP << SpawnSeed << Turrets;
+}
+
+void FWaveSnapshot::SaveToBytes(TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 Magic = WaveSnapshotMagic;
+	int32 Version = CurrentVersion;
+	Writer << Magic << Version;
+	Serialize(Writer);
+}
+
+bool FWaveSnapshot::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != WaveSnapshotMagic || Version != CurrentVersion)
+	{
+		return false;
+	}
+
+	Serialize(Reader);
+	return !Reader.IsError();
+}
+
+bool FWaveSnapshot::SaveToFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	SaveToBytes(Bytes);
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FWaveSnapshot::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	return FFileHelper::LoadFileToArray(Bytes, *FilePath) && LoadFromBytes(Bytes);
+}
@@ -17,6 +17,9 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "WizardPlayerController.h"
 #include "HotbarWidget.h"
+#include "SpellbookComponent.h"
+#include "CursorTraceComponent.h"
+#include "GameplayEventBus.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Misc/PackageName.h"
@@ -55,6 +58,9 @@ AWizardCharacter::AWizardCharacter()
 	FirstPersonMesh->bCastDynamicShadow = false;
 	FirstPersonMesh->CastShadow = false;
 
+	// Spell instances live here instead of being looked up in the world on every cast
+	Spellbook = CreateDefaultSubobject<USpellbookComponent>(TEXT("Spellbook"));
+
 	// Create staff mesh
 	StaffMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("StaffMesh"));
 	StaffMesh->SetupAttachment(FirstPersonMesh, StaffSocketName);
@@ -92,6 +98,8 @@ void AWizardCharacter::BeginPlay()
 	Super::BeginPlay();
 
 	// Initialize HP
+	SpawnTransform = GetActorTransform();
+
 	MaxHP = FMath::Max(MaxHP, 1.0f); // prevent zero/negative max that can break UI ratios
 	CurrentHP = MaxHP;
 	OnHealthChanged.Broadcast(CurrentHP, MaxHP);
@@ -120,6 +128,12 @@ void AWizardCharacter::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	UpdateMovementAnimation();
+
+	// Buffered casts fire on the first frame their slot comes off cooldown
+	if (CastBuffer.Num() > 0)
+	{
+		TryFireBufferedCast();
+	}
 }
 
 void AWizardCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -264,34 +278,119 @@ void AWizardCharacter::LookInput(const FInputActionValue& Value)
 
 void AWizardCharacter::DoCastSpell()
 {
-	// Don't cast if already casting (prevents animation cancelling)
-	if (bIsCasting)
+	// Don't cast if dead
+	if (CurrentHP <= 0.0f)
 	{
 		return;
 	}
 
-	// Don't cast if dead
-	if (CurrentHP <= 0.0f)
+	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetController());
+	UHotbarWidget* HotbarWidget = PC ? PC->GetHotbarWidget() : nullptr;
+
+	// Turret placement and the mode toggle aren't on a cooldown, so they skip the buffer
+	const bool bSpellSlot = HotbarWidget && HotbarWidget->GetCurrentMode() == EHotbarMode::Spells && HotbarWidget->GetCurrentSlotIndex() != 4;
+	if (!bSpellSlot)
 	{
+		// Don't cast if already casting (prevents animation cancelling)
+		if (!bIsCasting)
+		{
+			PerformCast();
+		}
 		return;
 	}
 
-	// Use hotbar spell instead of old system
-	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetController());
-	if (PC)
+	BufferCastIntent(HotbarWidget->GetCurrentSlotIndex());
+	TryFireBufferedCast();
+}
+
+void AWizardCharacter::BufferCastIntent(int32 SlotIndex)
+{
+	// World time, like the cooldowns, so the window follows pause and time dilation and replays buffer identically
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Held input re-triggers every frame; keep the oldest press so latency is measured from it
+	for (const FCastIntent& Intent : CastBuffer)
 	{
-		UHotbarWidget* HotbarWidget = PC->GetHotbarWidget();
-		if (HotbarWidget)
+		if (Intent.SlotIndex == SlotIndex && Now - Intent.Timestamp <= CastBufferWindow)
 		{
-			HotbarWidget->UseCurrentSlot();
+			return;
 		}
 	}
 
+	if (CastBuffer.Num() >= MaxBufferedCasts)
+	{
+		CastBuffer.RemoveAt(0, EAllowShrinking::No);
+	}
+
+	CastBuffer.Add({ Now, FPlatformTime::Seconds(), SlotIndex });
+}
+
+void AWizardCharacter::TryFireBufferedCast()
+{
+	if (CastBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Drop presses that have waited longer than the buffer window
+	CastBuffer.RemoveAll([this, Now](const FCastIntent& Intent)
+	{
+		return Now - Intent.Timestamp > CastBufferWindow;
+	});
+
+	if (CastBuffer.Num() == 0 || bIsCasting || CurrentHP <= 0.0f)
+	{
+		return;
+	}
+
+	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetController());
+	UHotbarWidget* HotbarWidget = PC ? PC->GetHotbarWidget() : nullptr;
+	const FCastIntent Intent = CastBuffer[0];
+
+	// The player switched slots or modes since pressing, that press no longer means anything
+	if (!HotbarWidget || HotbarWidget->GetCurrentMode() != EHotbarMode::Spells || HotbarWidget->GetCurrentSlotIndex() != Intent.SlotIndex)
+	{
+		CastBuffer.RemoveAt(0, EAllowShrinking::No);
+		return;
+	}
+
+	if (!Spellbook->IsSlotReady(Intent.SlotIndex))
+	{
+		return;
+	}
+
+	// A press that finds nothing to cast at (a lightning miss) is used up too, but costs no cooldown
+	CastBuffer.RemoveAt(0, EAllowShrinking::No);
+	if (PerformCast() == ESpellCastResult::Cast)
+	{
+		LastCastLatencyMs = static_cast<float>((FPlatformTime::Seconds() - Intent.InputTime) * 1000.0);
+		UE_LOG(LogTemp, Verbose, TEXT("WizardCharacter: Buffered cast fired %.1fms after input"), LastCastLatencyMs);
+	}
+}
+
+ESpellCastResult AWizardCharacter::PerformCast()
+{
+	AWizardPlayerController* PC = Cast<AWizardPlayerController>(GetController());
+	UHotbarWidget* HotbarWidget = PC ? PC->GetHotbarWidget() : nullptr;
+	if (!HotbarWidget)
+	{
+		return ESpellCastResult::NoSpell;
+	}
+
+	// Nothing to animate for a cooldown, a miss, turret placement or the mode toggle
+	const ESpellCastResult Result = HotbarWidget->UseCurrentSlot();
+	if (Result != ESpellCastResult::Cast)
+	{
+		return Result;
+	}
+
 	// Fallback: If no montage or sequence, just trigger the spell effect
 	if (!SpellCastMontage && !SpellCastAnimation)
 	{
 		BP_OnSpellCast();
-		return;
+		return Result;
 	}
 
 	USkeletalMeshComponent* MeshComp = nullptr;
@@ -349,11 +448,15 @@ void AWizardCharacter::DoCastSpell()
 
 	// Trigger spell effect
 	BP_OnSpellCast();
+	return Result;
 }
 
 void AWizardCharacter::OnCastMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
 	bIsCasting = false;
+
+	// Fire a press that came in during the animation on the frame the lock lifts
+	TryFireBufferedCast();
 }
 
 void AWizardCharacter::OnCastAnimationFinished()
@@ -381,6 +484,7 @@ void AWizardCharacter::OnCastAnimationFinished()
 	}
 
 	bIsCasting = false;
+	TryFireBufferedCast();
 }
 
 bool AWizardCharacter::GetAimData(FVector& OutOrigin, FVector& OutDirection) const
@@ -393,10 +497,10 @@ bool AWizardCharacter::GetAimData(FVector& OutOrigin, FVector& OutDirection) con
 
 		FVector Direction = GetActorForwardVector();
 
-		if (APlayerController* PC = Cast<APlayerController>(Controller))
+		if (AWizardPlayerController* PC = Cast<AWizardPlayerController>(Controller))
 		{
-			FHitResult CursorHit;
-			if (PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit))
+			const FCursorTraceResult& CursorHit = PC->GetCursorTrace()->GetCursorHit();
+			if (CursorHit.bValid && CursorHit.bFromCursor)
 			{
 				FVector Target = CursorHit.ImpactPoint;
 				Target.Z = Origin.Z;
@@ -544,12 +648,40 @@ void AWizardCharacter::Die()
 	OnCastAnimationFinished();
 	BP_OnDeath();
 
-	// Show death screen after a short delay (mirrors title screen flow)
-	FTimerHandle ReturnToDeathScreenTimer;
-	GetWorld()->GetTimerManager().SetTimer(ReturnToDeathScreenTimer, [this]()
+	// End the run after a short delay
+	FTimerHandle RunLostTimer;
+	GetWorld()->GetTimerManager().SetTimer(RunLostTimer, FTimerDelegate::CreateWeakLambda(this, [this]()
 	{
-		UGameplayStatics::OpenLevel(this, FName("DeathScreen"));
-	}, 2.0f, false);
+		if (CurrentHP > 0.0f)
+		{
+			return;
+		}
+
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			EventBus->OnRunLost.Broadcast();
+		}
+	}), 2.0f, false);
+}
+
+void AWizardCharacter::ResetForRestart()
+{
+	CurrentHP = MaxHP;
+	OnHealthChanged.Broadcast(CurrentHP, MaxHP);
+
+	CastBuffer.Reset();
+	Spellbook->ResetCooldowns();
+
+	GetCharacterMovement()->StopMovementImmediately();
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	if (Controller)
+	{
+		Controller->SetControlRotation(SpawnTransform.Rotator());
+	}
+
+	EnableInput(Cast<APlayerController>(Controller));
+
+	BP_OnRunRestarted();
 }
 
 void AWizardCharacter::UpdateMovementAnimation()
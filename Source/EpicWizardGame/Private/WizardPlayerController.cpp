@@ -3,25 +3,28 @@
 #include "WizardPlayerController.h"
 #include "HotbarWidget.h"
 #include "DeathScreenWidget.h"
+#include "HealthBarSubsystem.h"
+#include "SHealthBarOverlay.h"
+#include "CursorTraceComponent.h"
+#include "GameplayEventBus.h"
+#include "WaveManager.h"
+#include "EngineUtils.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
 #include "Kismet/GameplayStatics.h"
 
 AWizardPlayerController::AWizardPlayerController()
 {
 	DeathScreenWidget = nullptr;
+
+	CursorTrace = CreateDefaultSubobject<UCursorTraceComponent>(TEXT("CursorTrace"));
 }
 
 void AWizardPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Keep cursor visible for top-down aiming without needing a "click to focus"
-	FInputModeGameAndUI InputMode;
-	InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
-	InputMode.SetHideCursorDuringCapture(false);
-	SetInputMode(InputMode);
-	bShowMouseCursor = true;
-	bEnableClickEvents = true;
-	bEnableMouseOverEvents = true;
+	ApplyGameplayInputMode();
 
 	// If we're on the DeathScreen level, show a minimal death UI and route input to it
 	if (IsLocalPlayerController())
@@ -43,10 +46,131 @@ void AWizardPlayerController::BeginPlay()
 				bShowMouseCursor = true;
 			}
 		}
+		else if (!CurrentLevelName.Contains(TEXT("TitleScreen")))
+		{
+			// One overlay draws all floating health bars, underneath the rest of the UI
+			ULocalPlayer* LocalPlayer = GetLocalPlayer();
+			if (LocalPlayer && LocalPlayer->ViewportClient)
+			{
+				SAssignNew(HealthBarOverlay, SHealthBarOverlay, GetWorld()->GetSubsystem<UHealthBarSubsystem>(), this);
+				LocalPlayer->ViewportClient->AddViewportWidgetContent(HealthBarOverlay.ToSharedRef(), -1);
+			}
+
+			// Losing shows the death UI over the running world instead of loading the DeathScreen map
+			if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+			{
+				RunLostHandle = EventBus->OnRunLost.AddUObject(this, &AWizardPlayerController::OnRunLost);
+				RunRestartedHandle = EventBus->OnRunRestarted.AddUObject(this, &AWizardPlayerController::OnRunRestarted);
+			}
+		}
 	}
 }
 
+void AWizardPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnRunLost.Remove(RunLostHandle);
+		EventBus->OnRunRestarted.Remove(RunRestartedHandle);
+	}
+
+	if (HealthBarOverlay.IsValid())
+	{
+		ULocalPlayer* LocalPlayer = GetLocalPlayer();
+		if (LocalPlayer && LocalPlayer->ViewportClient)
+		{
+			LocalPlayer->ViewportClient->RemoveViewportWidgetContent(HealthBarOverlay.ToSharedRef());
+		}
+		HealthBarOverlay.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AWizardPlayerController::SetHotbarWidget(UHotbarWidget* Widget)
 {
 	HotbarWidget = Widget;
 }
+
+void AWizardPlayerController::ApplyGameplayInputMode()
+{
+	// Keep cursor visible for top-down aiming without needing a "click to focus"
+	FInputModeGameAndUI InputMode;
+	InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
+	InputMode.SetHideCursorDuringCapture(false);
+	SetInputMode(InputMode);
+	bShowMouseCursor = true;
+	bEnableClickEvents = true;
+	bEnableMouseOverEvents = true;
+}
+
+void AWizardPlayerController::OnRunLost()
+{
+	if (DeathScreenWidget && DeathScreenWidget->IsInViewport())
+	{
+		return;
+	}
+
+	if (!DeathScreenWidget)
+	{
+		DeathScreenWidget = CreateWidget<UDeathScreenWidget>(this, UDeathScreenWidget::StaticClass());
+		if (!DeathScreenWidget)
+		{
+			return;
+		}
+
+		DeathScreenWidget->OnTryAgain.BindUObject(this, &AWizardPlayerController::RestartRun);
+	}
+
+	// Offer a wave retry only when there is a wave start to roll back to
+	DeathScreenWidget->OnRetryWave.Unbind();
+	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
+	{
+		if (It->HasWaveStartSnapshot())
+		{
+			DeathScreenWidget->OnRetryWave.BindUObject(this, &AWizardPlayerController::RetryWave);
+		}
+		break;
+	}
+
+	DeathScreenWidget->AddToViewport(100);
+
+	FInputModeUIOnly DeathInputMode;
+	DeathInputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
+	DeathInputMode.SetWidgetToFocus(DeathScreenWidget->TakeWidget());
+	SetInputMode(DeathInputMode);
+	bShowMouseCursor = true;
+}
+
+void AWizardPlayerController::OnRunRestarted()
+{
+	if (DeathScreenWidget)
+	{
+		DeathScreenWidget->RemoveFromParent();
+	}
+
+	ApplyGameplayInputMode();
+}
+
+void AWizardPlayerController::RestartRun()
+{
+	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
+	{
+		It->RestartRun();
+		return;
+	}
+
+	// No wave manager to reset the world, fall back to reloading the level
+	FString CurrentLevelName = GetWorld()->GetMapName();
+	CurrentLevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
+	UGameplayStatics::OpenLevel(this, FName(*CurrentLevelName));
+}
+
+void AWizardPlayerController::RetryWave()
+{
+	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
+	{
+		It->RollbackToWaveStart();
+		return;
+	}
+}
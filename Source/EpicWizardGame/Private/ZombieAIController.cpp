@@ -4,17 +4,30 @@
 #include "ZombieCharacter.h"
 #include "Tower.h"
 #include "Turret.h"
+#include "AttackSlotComponent.h"
+#include "ZombieSquadSubsystem.h"
+#include "GameplayEventBus.h"
+#include "GameplayTimerSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "NavigationSystem.h"
 #include "EngineUtils.h"
+#include "Misc/ScopeExit.h"
+
+double AZombieAIController::AccumulatedUpdateTimeMs = 0.0;
 
 AZombieAIController::AZombieAIController()
 {
 }
 
+double AZombieAIController::ConsumeUpdateTimeMs()
+{
+	const double Result = AccumulatedUpdateTimeMs;
+	AccumulatedUpdateTimeMs = 0.0;
+	return Result;
+}
+
 void AZombieAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
@@ -28,14 +41,35 @@ void AZombieAIController::OnPossess(APawn* InPawn)
 		ZombieCharacter->OnZombieDeath.AddDynamic(this, &AZombieAIController::OnZombieDeath);
 
 		// Start AI update timer
-		GetWorld()->GetTimerManager().SetTimer(AIUpdateTimer, this, &AZombieAIController::UpdateAI, AIUpdateInterval, true);
+		if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+		{
+			Timers->ClearTimer(AIUpdateTimer);
+			AIUpdateTimer = Timers->SetTimer(EGameplayTimerCategory::ZombieAI, AIUpdateInterval,
+				FSimpleDelegate::CreateUObject(this, &AZombieAIController::UpdateAI), true);
+		}
+
+		if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+		{
+			NavMeshRebuiltHandle = EventBus->OnNavMeshRebuilt.AddUObject(this, &AZombieAIController::OnNavMeshRebuilt);
+		}
 	}
 }
 
 void AZombieAIController::OnUnPossess()
 {
 	// Clear timer
-	GetWorld()->GetTimerManager().ClearTimer(AIUpdateTimer);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->ClearTimer(AIUpdateTimer);
+	}
+
+	ReleaseAttackSlot();
+	LeaveSquad();
+
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnNavMeshRebuilt.Remove(NavMeshRebuiltHandle);
+	}
 
 	// Unbind death event
 	if (ZombieCharacter)
@@ -47,13 +81,36 @@ void AZombieAIController::OnUnPossess()
 	Super::OnUnPossess();
 }
 
+void AZombieAIController::OnNavMeshRebuilt()
+{
+	// Paths computed against the old tiles may run through new turrets
+	bHasSlotMove = false;
+	if (GetMoveStatus() == EPathFollowingStatus::Moving)
+	{
+		StopMovement();
+	}
+}
+
 void AZombieAIController::UpdateAI()
 {
+	// Track AI cost for the adaptive zombie cap
+	const double UpdateStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		AccumulatedUpdateTimeMs += (FPlatformTime::Seconds() - UpdateStartTime) * 1000.0;
+	};
+
 	if (!ZombieCharacter || ZombieCharacter->IsDead())
 	{
 		return;
 	}
 
+	// Squad followers skip target scoring and path queries entirely
+	if (UpdateAsSquadFollower())
+	{
+		return;
+	}
+
 	FVector ZombieLocation = GetPawn()->GetActorLocation();
 	AActor* BestTarget = nullptr;
 	float BestTargetScore = -FLT_MAX;
@@ -214,12 +271,65 @@ void AZombieAIController::UpdateAI()
 		}
 	}
 
+	// Leaders that switch targets leave their squad behind
+	if (BestTarget != CurrentTarget.Get())
+	{
+		LeaveSquad();
+	}
+
+	CurrentTarget = BestTarget;
+
 	// If no valid target found, do nothing
 	if (!BestTarget)
 	{
 		return;
 	}
 
+	// Still far from the target - lead a squad or fall in behind a nearby leader
+	if (bUseSquads && FVector::Dist(ZombieLocation, BestTarget->GetActorLocation()) > SquadBreakDistance)
+	{
+		UZombieSquadSubsystem* Squads = GetWorld()->GetSubsystem<UZombieSquadSubsystem>();
+		if (Squads && Squads->JoinOrFormSquad(this, BestTarget, SquadJoinRadius, MaxSquadSize))
+		{
+			ReleaseAttackSlot();
+			UpdateAsSquadFollower();
+			return;
+		}
+	}
+	else if (bUseSquads)
+	{
+		// Close enough to attack: a leader lets its squad go here, the same distance followers break off at
+		LeaveSquad();
+	}
+
+	// Structures hand out attack slots; drop our reservation when the target changes
+	UAttackSlotComponent* TargetSlots = nullptr;
+	if (ATower* Tower = Cast<ATower>(BestTarget))
+	{
+		TargetSlots = Tower->GetAttackSlots();
+	}
+	else if (ATurret* Turret = Cast<ATurret>(BestTarget))
+	{
+		TargetSlots = Turret->GetAttackSlots();
+	}
+
+	if (ReservedSlots.Get() != TargetSlots)
+	{
+		ReleaseAttackSlot();
+	}
+
+	if (TargetSlots)
+	{
+		ReservedSlots = TargetSlots;
+		const int32 NewSlotIndex = TargetSlots->ReserveSlot(ZombieCharacter);
+		if (NewSlotIndex != ReservedSlotIndex)
+		{
+			// Promoted from the queue (or handed a different slot) - issue a fresh move
+			bHasSlotMove = false;
+		}
+		ReservedSlotIndex = NewSlotIndex;
+	}
+
 	// Check if in attack range
 	float DistanceToTarget = FVector::Dist(ZombieLocation, BestTarget->GetActorLocation());
 	bool bInAttackRange = false;
@@ -229,9 +339,7 @@ void AZombieAIController::UpdateAI()
 	if (TargetTower)
 	{
 		// For towers, also check overlap (in case tower is vertically stretched)
-		TArray<AActor*> OverlappingActors;
-		ZombieCharacter->GetOverlappingActors(OverlappingActors, ATower::StaticClass());
-		bool bIsOverlapping = OverlappingActors.Contains(TargetTower);
+		const bool bIsOverlapping = ZombieCharacter->IsTouchingStructure(TargetTower);
 
 		// In range if either overlapping OR within distance
 		bInAttackRange = bIsOverlapping || (DistanceToTarget <= 300.0f);
@@ -239,9 +347,7 @@ void AZombieAIController::UpdateAI()
 	else if (TargetTurret)
 	{
 		// For turrets, allow overlap-based range (origin distance can be misleading)
-		TArray<AActor*> OverlappingActors;
-		ZombieCharacter->GetOverlappingActors(OverlappingActors, ATurret::StaticClass());
-		const bool bIsOverlapping = OverlappingActors.Contains(TargetTurret);
+		const bool bIsOverlapping = ZombieCharacter->IsTouchingStructure(TargetTurret);
 
 		// In range if either overlapping OR within distance
 		bInAttackRange = bIsOverlapping || (DistanceToTarget <= AttackDistance);
@@ -256,6 +362,7 @@ void AZombieAIController::UpdateAI()
 	{
 		// Stop moving
 		StopMovement();
+		bHasSlotMove = false;
 
 		// Face the target
 		FVector Direction = BestTarget->GetActorLocation() - ZombieLocation;
@@ -271,18 +378,123 @@ void AZombieAIController::UpdateAI()
 			ZombieCharacter->DoAttack();
 		}
 	}
+	else if (TargetSlots)
+	{
+		MoveToAttackSlot(TargetSlots);
+	}
 	else
 	{
 		// Move towards best target
 		MoveToActor(BestTarget, AcceptanceRadius);
+		bHasSlotMove = false;
 	}
 }
 
+bool AZombieAIController::UpdateAsSquadFollower()
+{
+	UZombieSquadSubsystem* Squads = GetWorld()->GetSubsystem<UZombieSquadSubsystem>();
+	AZombieAIController* Leader = Squads ? Squads->GetSquadLeader(this) : nullptr;
+	if (!Leader)
+	{
+		return false;
+	}
+
+	AActor* SquadTarget = Leader->GetCurrentTarget();
+	const APawn* LeaderPawn = Leader->GetPawn();
+	const FVector ZombieLocation = GetPawn()->GetActorLocation();
+
+	// Close to the target, or lost the leader - break formation and think for ourselves
+	if (!SquadTarget || !LeaderPawn
+		|| FVector::Dist(ZombieLocation, SquadTarget->GetActorLocation()) <= SquadBreakDistance
+		|| FVector::Dist(ZombieLocation, LeaderPawn->GetActorLocation()) > SquadSplitDistance)
+	{
+		LeaveSquad();
+		return false;
+	}
+
+	FVector FormationLocation;
+	if (!Squads->GetFormationLocation(this, SquadFormationSpacing, FormationLocation))
+	{
+		LeaveSquad();
+		return false;
+	}
+
+	// Formation spot must be reachable in a straight line, otherwise we've split off the leader's corridor
+	FVector NavHitLocation;
+	if (UNavigationSystemV1::NavigationRaycast(this, ZombieLocation, FormationLocation, NavHitLocation, nullptr, this))
+	{
+		LeaveSquad();
+		return false;
+	}
+
+	CurrentTarget = SquadTarget;
+	bHasSlotMove = false;
+
+	// Direct move along the leader's corridor - no path query
+	MoveToLocation(FormationLocation, AcceptanceRadius, true, false, true);
+	return true;
+}
+
+void AZombieAIController::LeaveSquad()
+{
+	if (UZombieSquadSubsystem* Squads = GetWorld()->GetSubsystem<UZombieSquadSubsystem>())
+	{
+		Squads->LeaveSquad(this);
+	}
+}
+
+void AZombieAIController::MoveToAttackSlot(UAttackSlotComponent* Slots)
+{
+	const bool bHasSlot = ReservedSlotIndex != INDEX_NONE;
+	const FVector Goal = bHasSlot ? Slots->GetSlotLocation(ReservedSlotIndex) : Slots->GetQueueLocation(GetPawn());
+
+	// Already waiting at the queue position - hold still until a slot frees up
+	if (!bHasSlot && FVector::Dist2D(GetPawn()->GetActorLocation(), Goal) <= SlotRepathTolerance)
+	{
+		if (bHasSlotMove)
+		{
+			StopMovement();
+			bHasSlotMove = false;
+		}
+		return;
+	}
+
+	// Re-issuing an identical move every update forces a repath, so only move when the goal changed or we stopped
+	const bool bStillMoving = GetMoveStatus() == EPathFollowingStatus::Moving;
+	if (bHasSlotMove && bStillMoving && FVector::Dist2D(SlotMoveGoal, Goal) <= SlotRepathTolerance)
+	{
+		return;
+	}
+
+	MoveToLocation(Goal, bHasSlot ? SlotAcceptanceRadius : AcceptanceRadius);
+	SlotMoveGoal = Goal;
+	bHasSlotMove = true;
+}
+
+void AZombieAIController::ReleaseAttackSlot()
+{
+	if (UAttackSlotComponent* Slots = ReservedSlots.Get())
+	{
+		Slots->ReleaseSlot(GetPawn());
+	}
+
+	ReservedSlots = nullptr;
+	ReservedSlotIndex = INDEX_NONE;
+	bHasSlotMove = false;
+}
+
 void AZombieAIController::OnZombieDeath()
 {
 	// Stop AI updates
-	GetWorld()->GetTimerManager().ClearTimer(AIUpdateTimer);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->ClearTimer(AIUpdateTimer);
+	}
 
 	// Stop movement
 	StopMovement();
+
+	// Free our slot for the next zombie in line
+	ReleaseAttackSlot();
+	LeaveSquad();
 }
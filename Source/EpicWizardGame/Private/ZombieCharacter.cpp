@@ -1,6 +1,13 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ZombieCharacter.h"
+#include "ZombieAIController.h"
+#include "ZombieSpatialGridSubsystem.h"
+#include "HealthBarSubsystem.h"
+#include "GameplayEventBus.h"
+#include "GameplayTimerSubsystem.h"
+#include "GameplayScratch.h"
+#include "EpicWizardGame.h"
 #include "Tower.h"
 #include "Turret.h"
 #include "Animation/AnimInstance.h"
@@ -11,12 +18,8 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/WidgetComponent.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
-#include "EngineUtils.h"
-#include "UObject/ConstructorHelpers.h"
 
 AZombieCharacter::AZombieCharacter()
 {
@@ -26,57 +29,61 @@ AZombieCharacter::AZombieCharacter()
 	// AI controlled
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 
-	// Create floating health bar widget
-	HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidget->SetupAttachment(RootComponent);
-	HealthBarWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 100.0f)); // Above head
-	HealthBarWidget->SetWidgetSpace(EWidgetSpace::Screen); // Always face camera
-	HealthBarWidget->SetDrawSize(FVector2D(200.0f, 20.0f));
-
 	// Make zombies slower
 	GetCharacterMovement()->MaxWalkSpeed = 200.0f; // Default is usually 600
 
-	// Default to the zombie-specific walk animation
-	static ConstructorHelpers::FObjectFinder<UAnimSequenceBase> ZombieWalkAsset(TEXT("/Game/WizardsLastStand/Assets/Characters/ZombieWalk.ZombieWalk"));
-	if (ZombieWalkAsset.Succeeded())
-	{
-		WalkAnimation = ZombieWalkAsset.Object;
-	}
-
-	// Default to the zombie-specific attack animation
-	static ConstructorHelpers::FObjectFinder<UAnimSequenceBase> ZombieAttackAsset(TEXT("/Game/WizardsLastStand/Assets/Characters/ZombieAttack.ZombieAttack"));
-	if (ZombieAttackAsset.Succeeded())
-	{
-		AttackAnimation = ZombieAttackAsset.Object;
-	}
+	// Default to the zombie-specific walk and attack animations, by path only so the wave preload loads them
+	WalkAnimation = TSoftObjectPtr<UAnimSequenceBase>(FSoftObjectPath(TEXT("/Game/WizardsLastStand/Assets/Characters/ZombieWalk.ZombieWalk")));
+	AttackAnimation = TSoftObjectPtr<UAnimSequenceBase>(FSoftObjectPath(TEXT("/Game/WizardsLastStand/Assets/Characters/ZombieAttack.ZombieAttack")));
 }
 
 void AZombieCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Check if we're in a menu screen - if so, hide health bar
-	FString CurrentLevelName = GetWorld()->GetMapName();
-	CurrentLevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
-	if (CurrentLevelName.Contains(TEXT("TitleScreen")) || CurrentLevelName.Contains(TEXT("DeathScreen")))
+	// Initialize HP
+	CurrentHP = MaxHP;
+
+	// Floating health bar (drawn by the HUD overlay, which only exists in gameplay levels)
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
 	{
-		if (HealthBarWidget)
-		{
-			HealthBarWidget->SetVisibility(false);
-		}
+		HealthBarHandle = HealthBars->RegisterHealthBar(this, HealthBarHeight, HealthBarSize);
 	}
 
-	// Initialize HP
-	CurrentHP = MaxHP;
+	// Zombies on their own object channel ignore each other; separation steering keeps them apart
+	if (bUseSeparationSteering)
+	{
+		GetCapsuleComponent()->SetCollisionObjectType(ECC_Zombie);
+		GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Zombie, ECollisionResponse::ECR_Ignore);
+	}
+
+	SpatialGrid = GetWorld()->GetSubsystem<UZombieSpatialGridSubsystem>();
+	if (SpatialGrid.IsValid())
+	{
+		SpatialGrid->RegisterZombie(this);
+	}
 }
 
 void AZombieCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (SpatialGrid.IsValid())
+	{
+		SpatialGrid->UnregisterZombie(this);
+	}
+
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->UnregisterHealthBar(HealthBarHandle);
+	}
+
 	// Clear timers
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
-	GetWorld()->GetTimerManager().ClearTimer(AttackAnimationTimer);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->ClearTimer(DeathTimer);
+		Timers->ClearTimer(AttackAnimationTimer);
+	}
 }
 
 void AZombieCharacter::Tick(float DeltaTime)
@@ -84,6 +91,11 @@ void AZombieCharacter::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	UpdateMovementAnimation();
+
+	if (bUseSeparationSteering && !bIsDead)
+	{
+		ApplySeparationSteering(DeltaTime);
+	}
 }
 
 float AZombieCharacter::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -94,6 +106,8 @@ float AZombieCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	}
 
 	CurrentHP -= Damage;
+	LastDamageCauser = DamageCauser;
+	UpdateHealthBar();
 
 	if (CurrentHP <= 0.0f)
 	{
@@ -103,6 +117,14 @@ float AZombieCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	return Damage;
 }
 
+void AZombieCharacter::UpdateHealthBar()
+{
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->SetHealthPercent(HealthBarHandle, GetHealthPercent());
+	}
+}
+
 void AZombieCharacter::DoAttack()
 {
 	// Don't attack if already attacking or dead
@@ -111,8 +133,10 @@ void AZombieCharacter::DoAttack()
 		return;
 	}
 
+	UAnimSequenceBase* AttackSequence = GetAttackAnimation();
+
 	// If no montage, just apply damage
-	if (!AttackMontage && !AttackAnimation)
+	if (!AttackMontage && !AttackSequence)
 	{
 		ApplyAttackDamage();
 		BP_OnAttack();
@@ -142,7 +166,7 @@ void AZombieCharacter::DoAttack()
 			bIsAttacking = false;
 		}
 	}
-	else if (AttackAnimation && MeshComp)
+	else if (AttackSequence && MeshComp)
 	{
 		bIsAttacking = true;
 
@@ -172,14 +196,18 @@ void AZombieCharacter::DoAttack()
 		AttackSingleNodeMesh = MeshComp;
 		bUsingAttackSingleNode = true;
 
-		MeshComp->PlayAnimation(AttackAnimation, false);
+		MeshComp->PlayAnimation(AttackSequence, false);
 
 		if (UAnimSingleNodeInstance* SingleNode = MeshComp->GetSingleNodeInstance())
 		{
 			SingleNode->SetPlayRate(AttackAnimPlayRate);
 			const float Duration = SingleNode->GetLength() / FMath::Max(AttackAnimPlayRate, KINDA_SMALL_NUMBER);
-			GetWorld()->GetTimerManager().ClearTimer(AttackAnimationTimer);
-			GetWorld()->GetTimerManager().SetTimer(AttackAnimationTimer, this, &AZombieCharacter::OnAttackAnimationFinished, Duration, false);
+			if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+			{
+				Timers->ClearTimer(AttackAnimationTimer);
+				AttackAnimationTimer = Timers->SetTimer(EGameplayTimerCategory::ZombieAnimation, Duration,
+					FSimpleDelegate::CreateUObject(this, &AZombieCharacter::OnAttackAnimationFinished));
+			}
 		}
 		else
 		{
@@ -199,7 +227,10 @@ void AZombieCharacter::OnAttackMontageEnded(UAnimMontage* Montage, bool bInterru
 
 void AZombieCharacter::OnAttackAnimationFinished()
 {
-	GetWorld()->GetTimerManager().ClearTimer(AttackAnimationTimer);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->ClearTimer(AttackAnimationTimer);
+	}
 
 	if (bUsingAttackSingleNode)
 	{
@@ -249,46 +280,50 @@ void AZombieCharacter::ApplyAttackDamage()
 		}
 	}
 
-	// Collect overlaps once (towers/turrets may be tall or have complex collision)
-	TArray<AActor*> OverlappingTowers;
-	GetOverlappingActors(OverlappingTowers, ATower::StaticClass());
-
-	TArray<AActor*> OverlappingTurrets;
-	GetOverlappingActors(OverlappingTurrets, ATurret::StaticClass());
-
-	// Check all towers using collision overlap instead of distance
-	// This allows zombies to damage vertically stretched towers
-	for (TActorIterator<ATower> It(GetWorld()); It; ++It)
+	// Towers/turrets whose attack box we're inside (tracked from their overlap events,
+	// so vertically stretched towers can still be hit)
+	for (const TWeakObjectPtr<AActor>& Structure : TouchingStructures)
 	{
-		ATower* Tower = *It;
-		if (Tower && !Tower->IsDestroyed())
+		AActor* StructureActor = Structure.Get();
+		if (!StructureActor)
 		{
-			if (OverlappingTowers.Contains(Tower))
+			continue;
+		}
+
+		if (const ATower* Tower = Cast<ATower>(StructureActor))
+		{
+			if (Tower->IsDestroyed())
 			{
-				// Prioritize tower if we're overlapping with it
-				float TowerDistance = FVector::Dist(ZombieLocation, Tower->GetActorLocation());
-				if (TowerDistance < NearestDistance)
-				{
-					NearestDistance = TowerDistance;
-					NearestTarget = Tower;
-				}
+				continue;
 			}
 		}
+		else if (const ATurret* Turret = Cast<ATurret>(StructureActor))
+		{
+			if (Turret->IsDestroyed() || Turret->IsPreviewTurret())
+			{
+				continue;
+			}
+		}
+
+		const float StructureDistance = FVector::Dist(ZombieLocation, StructureActor->GetActorLocation());
+		if (StructureDistance < NearestDistance)
+		{
+			NearestDistance = StructureDistance;
+			NearestTarget = StructureActor;
+		}
 	}
 
-	// Check turrets (prefer overlaps; also allow close-range distance attacks)
-	for (TActorIterator<ATurret> It(GetWorld()); It; ++It)
+	// Also allow close-range hits on the turret we're chasing even if we aren't inside its box yet
+	if (AZombieAIController* ZombieController = Cast<AZombieAIController>(AIController))
 	{
-		ATurret* Turret = *It;
-		if (Turret && !Turret->IsDestroyed() && !Turret->IsPreviewTurret())
+		ATurret* TargetTurret = Cast<ATurret>(ZombieController->GetCurrentTarget());
+		if (TargetTurret && !TargetTurret->IsDestroyed() && !TargetTurret->IsPreviewTurret())
 		{
-			const float TurretDistance = FVector::Dist(ZombieLocation, Turret->GetActorLocation());
-			const bool bCanHitTurret = OverlappingTurrets.Contains(Turret) || (TurretDistance <= AttackRange);
-
-			if (bCanHitTurret && TurretDistance < NearestDistance)
+			const float TurretDistance = FVector::Dist(ZombieLocation, TargetTurret->GetActorLocation());
+			if (TurretDistance <= AttackRange && TurretDistance < NearestDistance)
 			{
 				NearestDistance = TurretDistance;
-				NearestTarget = Turret;
+				NearestTarget = TargetTurret;
 			}
 		}
 	}
@@ -325,7 +360,10 @@ void AZombieCharacter::Die()
 	bIsDead = true;
 	bIsAttacking = false;
 
-	GetWorld()->GetTimerManager().ClearTimer(AttackAnimationTimer);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->ClearTimer(AttackAnimationTimer);
+	}
 	OnAttackAnimationFinished();
 
 	// Stop movement
@@ -334,15 +372,36 @@ void AZombieCharacter::Die()
 
 	// Disable collision
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TouchingStructures.Reset();
+
+	// Dead zombies no longer take part in neighbour queries or show a health bar
+	if (SpatialGrid.IsValid())
+	{
+		SpatialGrid->UnregisterZombie(this);
+	}
 
-	// Broadcast death
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->UnregisterHealthBar(HealthBarHandle);
+	}
+
+	// Broadcast death (our own controller listens here, game systems listen on the event bus)
 	OnZombieDeath.Broadcast();
 
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnZombieDied.Broadcast(this);
+	}
+
 	// Call blueprint event
 	BP_OnDeath();
 
 	// Schedule destruction
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &AZombieCharacter::DeferredDestruction, DeathDestroyDelay, false);
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		DeathTimer = Timers->SetTimer(EGameplayTimerCategory::ZombieDeath, DeathDestroyDelay,
+			FSimpleDelegate::CreateUObject(this, &AZombieCharacter::DeferredDestruction));
+	}
 }
 
 void AZombieCharacter::DeferredDestruction()
@@ -350,10 +409,64 @@ void AZombieCharacter::DeferredDestruction()
 	Destroy();
 }
 
+void AZombieCharacter::ApplySeparationSteering(float DeltaTime)
+{
+	UZombieSpatialGridSubsystem* Grid = SpatialGrid.Get();
+	if (!Grid)
+	{
+		return;
+	}
+
+	const FVector MyLocation = GetActorLocation();
+
+	FGameplayScratchScope Scratch;
+	TScratchArray<AZombieCharacter*> Neighbors;
+	Grid->QueryRadius(MyLocation, SeparationRadius, Neighbors);
+
+	// Boids-style separation: each close neighbour pushes harder the more we overlap
+	FVector Push = FVector::ZeroVector;
+	int32 NumConsidered = 0;
+
+	for (AZombieCharacter* Neighbor : Neighbors)
+	{
+		if (Neighbor == this)
+		{
+			continue;
+		}
+
+		FVector Away = MyLocation - Neighbor->GetActorLocation();
+		Away.Z = 0.0f;
+		const float Distance = Away.Size();
+
+		if (Distance >= SeparationRadius)
+		{
+			continue;
+		}
+
+		// Perfectly stacked zombies get split along a stable per-pair direction
+		const FVector Direction = Distance > KINDA_SMALL_NUMBER ? Away / Distance : (GetUniqueID() < Neighbor->GetUniqueID() ? FVector::RightVector : FVector::LeftVector);
+		Push += Direction * (1.0f - Distance / SeparationRadius);
+
+		if (++NumConsidered >= MaxSeparationNeighbors)
+		{
+			break;
+		}
+	}
+
+	if (Push.IsNearlyZero())
+	{
+		return;
+	}
+
+	// Sweep so the push never shoves us into structures or walls
+	const FVector Offset = Push.GetClampedToMaxSize(1.0f) * SeparationSpeed * DeltaTime;
+	AddActorWorldOffset(Offset, true);
+}
+
 void AZombieCharacter::UpdateMovementAnimation()
 {
 	USkeletalMeshComponent* MeshComp = GetMesh();
-	if (!MeshComp || !WalkAnimation)
+	if (!MeshComp || WalkAnimation.IsNull())
 	{
 		return;
 	}
@@ -399,7 +512,7 @@ void AZombieCharacter::UpdateMovementAnimation()
 			WalkSingleNodeMesh = MeshComp;
 			bUsingSingleNodeWalk = true;
 
-			MeshComp->PlayAnimation(WalkAnimation, true);
+			MeshComp->PlayAnimation(GetWalkAnimation(), true);
 		}
 
 		if (UAnimSingleNodeInstance* SingleNode = MeshComp->GetSingleNodeInstance())
@@ -427,3 +540,44 @@ void AZombieCharacter::UpdateMovementAnimation()
 		SavedWalkAnimClass = nullptr;
 	}
 }
+
+void AZombieCharacter::GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const
+{
+	const UObject* Assets[] = { GetMesh() ? GetMesh()->GetSkeletalMeshAsset() : nullptr, AttackMontage };
+	for (const UObject* Asset : Assets)
+	{
+		if (Asset)
+		{
+			OutAssets.AddUnique(FSoftObjectPath(Asset));
+		}
+	}
+
+	for (const TSoftObjectPtr<UAnimSequenceBase>& Animation : { WalkAnimation, AttackAnimation })
+	{
+		if (!Animation.IsNull())
+		{
+			OutAssets.AddUnique(Animation.ToSoftObjectPath());
+		}
+	}
+}
+
+UAnimSequenceBase* AZombieCharacter::GetAttackAnimation() const
+{
+	// Normally preloaded for the wave; load it here if that didn't happen
+	return AttackAnimation.LoadSynchronous();
+}
+
+void AZombieCharacter::SetAttackAnimation(UAnimSequenceBase* NewAnimation)
+{
+	AttackAnimation = TSoftObjectPtr<UAnimSequenceBase>(NewAnimation);
+}
+
+UAnimSequenceBase* AZombieCharacter::GetWalkAnimation() const
+{
+	return WalkAnimation.LoadSynchronous();
+}
+
+void AZombieCharacter::SetWalkAnimation(UAnimSequenceBase* NewAnimation)
+{
+	WalkAnimation = TSoftObjectPtr<UAnimSequenceBase>(NewAnimation);
+}
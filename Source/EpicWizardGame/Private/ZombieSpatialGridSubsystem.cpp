@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZombieSpatialGridSubsystem.h"
+#include "ZombieCharacter.h"
+
+void UZombieSpatialGridSubsystem::RegisterZombie(AZombieCharacter* Zombie)
+{
+	if (Zombie)
+	{
+		Zombies.AddUnique(Zombie);
+	}
+}
+
+void UZombieSpatialGridSubsystem::UnregisterZombie(AZombieCharacter* Zombie)
+{
+	// Stale bucket entries are skipped by queries until the next rebuild
+	Zombies.RemoveSwap(Zombie);
+}
+
+void UZombieSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RebuildGrid();
+}
+
+TStatId UZombieSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UZombieSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+void UZombieSpatialGridSubsystem::RebuildGrid()
+{
+	for (TPair<FIntPoint, TArray<FGridEntry>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (int32 i = Zombies.Num() - 1; i >= 0; i--)
+	{
+		AZombieCharacter* Zombie = Zombies[i].Get();
+		if (!Zombie)
+		{
+			Zombies.RemoveAtSwap(i);
+			continue;
+		}
+
+		const FVector Location = Zombie->GetActorLocation();
+		Cells.FindOrAdd(GetCell(Location)).Add({ Zombie, Location });
+	}
+}
+
+void UZombieSpatialGridSubsystem::ForEachInRadius(const FVector& Location, float Radius, TFunctionRef<void(AZombieCharacter*)> Visitor) const
+{
+	const FIntPoint MinCell = GetCell(Location - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell = GetCell(Location + FVector(Radius, Radius, 0.0f));
+	const float RadiusSq = FMath::Square(Radius);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<FGridEntry>* Bucket = Cells.Find(FIntPoint(X, Y));
+			if (!Bucket)
+			{
+				continue;
+			}
+
+			for (const FGridEntry& Entry : *Bucket)
+			{
+				if (FVector::DistSquared2D(Location, Entry.Location) > RadiusSq)
+				{
+					continue;
+				}
+
+				AZombieCharacter* Zombie = Entry.Zombie.Get();
+				if (Zombie && !Zombie->IsDead())
+				{
+					Visitor(Zombie);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UZombieSpatialGridSubsystem::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
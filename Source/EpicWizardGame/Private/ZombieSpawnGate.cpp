@@ -3,6 +3,7 @@
 
 #include "ZombieSpawnGate.h"
 #include "ZombieCharacter.h"
+#include "GameplayEventBus.h"
 #include "Components/BoxComponent.h"
 #include "Components/ArrowComponent.h"
 
@@ -56,6 +57,9 @@ AZombieSpawnGate::AZombieSpawnGate()
 	SpawnDirection->ArrowSize = 2.0f;
 	SpawnDirection->ArrowColor = FColor::Red;
 	SpawnDirection->bIsScreenSizeScaled = true;
+
+	// Random until the spawn manager seeds it
+	SpawnStream.GenerateNewSeed();
 }
 
 // Called when the game starts or when spawned
@@ -63,6 +67,20 @@ void AZombieSpawnGate::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		ZombieDiedHandle = EventBus->OnZombieDied.AddUObject(this, &AZombieSpawnGate::OnZombieDied);
+	}
+}
+
+void AZombieSpawnGate::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnZombieDied.Remove(ZombieDiedHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -80,12 +98,25 @@ AZombieCharacter* AZombieSpawnGate::SpawnZombie()
 	}
 
 	// Check if zombie class is set
-	if (!ZombieClass)
+	if (ZombieClass.IsNull())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ZombieSpawnGate: No zombie class set!"));
 		return nullptr;
 	}
 
+	// Normally preloaded for the wave; load it here if that didn't happen
+	TSubclassOf<AZombieCharacter> SpawnClass = ZombieClass.Get();
+	if (!SpawnClass)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ZombieSpawnGate: %s wasn't preloaded, loading it now"), *ZombieClass.ToString());
+		SpawnClass = ZombieClass.LoadSynchronous();
+		if (!SpawnClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ZombieSpawnGate: Failed to load %s"), *ZombieClass.ToString());
+			return nullptr;
+		}
+	}
+
 	// Get spawn location
 	FVector SpawnLocation = GetRandomSpawnLocation();
 	// Use the arrow's forward direction as spawn rotation
@@ -96,15 +127,12 @@ AZombieCharacter* AZombieSpawnGate::SpawnZombie()
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
 	// Spawn the zombie
-	AZombieCharacter* NewZombie = GetWorld()->SpawnActor<AZombieCharacter>(ZombieClass, SpawnLocation, SpawnRotation, SpawnParams);
+	AZombieCharacter* NewZombie = GetWorld()->SpawnActor<AZombieCharacter>(SpawnClass, SpawnLocation, SpawnRotation, SpawnParams);
 
 	if (NewZombie)
 	{
 		// Add to active zombies
 		ActiveZombies.Add(NewZombie);
-
-		// Bind to death delegate
-		NewZombie->OnZombieDeath.AddDynamic(this, &AZombieSpawnGate::OnZombieDied);
 	}
 
 	return NewZombie;
@@ -119,10 +147,10 @@ bool AZombieSpawnGate::CanSpawn() const
 	return ActiveZombies.Num() < MaxActiveZombiesPerGate;
 }
 
-void AZombieSpawnGate::OnZombieDied()
+void AZombieSpawnGate::OnZombieDied(AZombieCharacter* Zombie)
 {
-	// Clean up dead zombies from the array
-	CleanupDeadZombies();
+	// Only zombies from this gate are in the list
+	ActiveZombies.RemoveSwap(Zombie);
 }
 
 void AZombieSpawnGate::CleanupDeadZombies()
@@ -141,9 +169,9 @@ FVector AZombieSpawnGate::GetRandomSpawnLocation() const
 	FVector Center = GetActorLocation();
 
 	// Generate random offset within the box
-	float RandomX = FMath::RandRange(-Extent.X, Extent.X);
-	float RandomY = FMath::RandRange(-Extent.Y, Extent.Y);
-	float RandomZ = FMath::RandRange(-Extent.Z, Extent.Z);
+	float RandomX = SpawnStream.FRandRange(-Extent.X, Extent.X);
+	float RandomY = SpawnStream.FRandRange(-Extent.Y, Extent.Y);
+	float RandomZ = SpawnStream.FRandRange(-Extent.Z, Extent.Z);
 
 	// Transform the offset by the actor's rotation
 	FVector LocalOffset(RandomX, RandomY, RandomZ);
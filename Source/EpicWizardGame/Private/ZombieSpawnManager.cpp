@@ -5,14 +5,23 @@
 #include "ZombieSpawnGate.h"
 #include "ZombieCharacter.h"
 #include "WaveManager.h"
+#include "ZombieAIController.h"
+#include "GameplayEventBus.h"
+#include "GameplayRandomSubsystem.h"
+#include "InputReplaySubsystem.h"
+#include "WaveSimulationSubsystem.h"
+#include "GameplayScratch.h"
 #include "EngineUtils.h"
 #include "TimerManager.h"
+#include "RenderCore.h"
+#include "Misc/App.h"
 
 // Sets default values
 AZombieSpawnManager::AZombieSpawnManager()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
+ 	// Only ticks when the adaptive zombie cap is enabled (frame cost sampling)
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 // Called when the game starts or when spawned
@@ -31,6 +40,37 @@ void AZombieSpawnManager::BeginPlay()
 
 	// Find all spawn gates in the level
 	FindSpawnGates();
+	if (UGameplayRandomSubsystem* Random = UGameplayRandomSubsystem::Get(this))
+	{
+		SetRandomSeed(Random->NextSeed(EGameplayRandomStream::ZombieSpawning));
+	}
+
+	// The adaptive cap follows measured frame cost, so it would make replays and wave simulator runs play out
+	// differently per machine. Both start in OnWorldBeginPlay, before any actor's BeginPlay
+	const UInputReplaySubsystem* Replay = GetWorld()->GetSubsystem<UInputReplaySubsystem>();
+	const UWaveSimulationSubsystem* WaveSim = GetWorld()->GetSubsystem<UWaveSimulationSubsystem>();
+	if ((Replay && (Replay->IsRecording() || Replay->IsPlaying())) || (WaveSim && WaveSim->IsRunning()))
+	{
+		bUseAdaptiveZombieCap = false;
+	}
+
+	// Drop zombies from the active list as they die
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		ZombieDiedHandle = EventBus->OnZombieDied.AddUObject(this, &AZombieSpawnManager::OnZombieDied);
+	}
+
+	// Start the adaptive cap at the designer value and sample frame cost every tick
+	if (bUseAdaptiveZombieCap)
+	{
+		MaxAdaptiveZombieCap = FMath::Max(MaxAdaptiveZombieCap, MinAdaptiveZombieCap);
+		AdaptiveZombieCap = FMath::Clamp(MaxTotalZombies, MinAdaptiveZombieCap, MaxAdaptiveZombieCap);
+		SmoothedGameThreadMs = 0.0f;
+		SmoothedAIMs = 0.0f;
+		TimeSinceCapAdjustment = 0.0f;
+		AZombieAIController::ConsumeUpdateTimeMs();
+		SetActorTickEnabled(true);
+	}
 
 	// Try to find wave manager
 	for (TActorIterator<AWaveManager> It(GetWorld()); It; ++It)
@@ -47,10 +87,25 @@ void AZombieSpawnManager::BeginPlay()
 	}
 }
 
+void AZombieSpawnManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayEventBus* EventBus = UGameplayEventBus::Get(this))
+	{
+		EventBus->OnZombieDied.Remove(ZombieDiedHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AZombieSpawnManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	if (bUseAdaptiveZombieCap)
+	{
+		UpdateAdaptiveCap(DeltaTime);
+	}
 }
 
 void AZombieSpawnManager::StartSpawning()
@@ -104,8 +159,8 @@ void AZombieSpawnManager::TrySpawnZombie()
 		return;
 	}
 
-	// Check if we're at max alive capacity
-	if (ActiveZombies.Num() >= MaxTotalZombies)
+	// Check if we're at max alive capacity (remaining wave zombies stay queued)
+	if (ActiveZombies.Num() >= GetMaxTotalZombies())
 	{
 		return;
 	}
@@ -118,7 +173,8 @@ void AZombieSpawnManager::TrySpawnZombie()
 	}
 
 	// Try to find a gate that can spawn
-	TArray<AZombieSpawnGate*> AvailableGates;
+	FGameplayScratchScope Scratch;
+	TScratchArray<AZombieSpawnGate*> AvailableGates;
 	for (AZombieSpawnGate* Gate : SpawnGates)
 	{
 		if (Gate && Gate->CanSpawn())
@@ -134,7 +190,7 @@ void AZombieSpawnManager::TrySpawnZombie()
 	}
 
 	// Pick a random available gate
-	int32 RandomIndex = FMath::RandRange(0, AvailableGates.Num() - 1);
+	int32 RandomIndex = GateStream.RandRange(0, AvailableGates.Num() - 1);
 	AZombieSpawnGate* SelectedGate = AvailableGates[RandomIndex];
 
 	// Spawn zombie from the selected gate
@@ -155,24 +211,62 @@ void AZombieSpawnManager::TrySpawnZombie()
 		// Increment spawned counter
 		TotalZombiesSpawned++;
 
-		// Bind to death event
-		NewZombie->OnZombieDeath.AddDynamic(this, &AZombieSpawnManager::OnZombieDied);
-
 		UE_LOG(LogTemp, Log, TEXT("ZombieSpawnManager: Spawned zombie %d/%d (HP: %.0f). Alive: %d/%d"),
-			TotalZombiesSpawned, TotalZombiesToSpawn, NewZombie->CurrentHP, ActiveZombies.Num(), MaxTotalZombies);
+			TotalZombiesSpawned, TotalZombiesToSpawn, NewZombie->CurrentHP, ActiveZombies.Num(), GetMaxTotalZombies());
 	}
 }
 
-void AZombieSpawnManager::OnZombieDied()
+void AZombieSpawnManager::OnZombieDied(AZombieCharacter* Zombie)
 {
-	// Notify wave manager if it exists
-	if (WaveManager)
+	ActiveZombies.RemoveSwap(Zombie);
+}
+
+void AZombieSpawnManager::DespawnAllZombies()
+{
+	StopSpawning();
+
+	// Copy first, destroying a zombie can touch ActiveZombies through its EndPlay
+	TArray<AZombieCharacter*> ZombiesToRemove = ActiveZombies;
+	ActiveZombies.Reset();
+	for (AZombieCharacter* Zombie : ZombiesToRemove)
 	{
-		WaveManager->OnZombieDied();
+		if (IsValid(Zombie))
+		{
+			Zombie->Destroy();
+		}
 	}
 
-	// Clean up dead zombies
-	CleanupDeadZombies();
+	TotalZombiesSpawned = 0;
+	TotalZombiesToSpawn = 0;
+}
+
+void AZombieSpawnManager::SetRandomSeed(int32 Seed)
+{
+	RandomSeed = Seed;
+	GateStream.Initialize(Seed);
+
+	// Gates come from an actor iterator, so their order (and derived seeds) is stable for a given level
+	for (int32 GateIndex = 0; GateIndex < SpawnGates.Num(); GateIndex++)
+	{
+		if (SpawnGates[GateIndex])
+		{
+			SpawnGates[GateIndex]->SetRandomSeed(static_cast<int32>(HashCombine(static_cast<uint32>(Seed), static_cast<uint32>(GateIndex))));
+		}
+	}
+}
+
+int32 AZombieSpawnManager::GetAliveZombieCount() const
+{
+	int32 AliveCount = 0;
+	for (const AZombieCharacter* Zombie : ActiveZombies)
+	{
+		if (IsValid(Zombie) && !Zombie->IsDead())
+		{
+			AliveCount++;
+		}
+	}
+
+	return AliveCount;
 }
 
 void AZombieSpawnManager::CleanupDeadZombies()
@@ -184,3 +278,57 @@ void AZombieSpawnManager::CleanupDeadZombies()
 	});
 }
 
+void AZombieSpawnManager::UpdateAdaptiveCap(float DeltaTime)
+{
+	// GGameThreadTime is only written when a viewport draws; fall back to frame delta when headless
+	float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	if (GameThreadMs <= 0.0f)
+	{
+		GameThreadMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+	}
+
+	const float AIMs = static_cast<float>(AZombieAIController::ConsumeUpdateTimeMs());
+
+	// Exponential moving average so single spikes don't move the cap
+	if (SmoothedGameThreadMs <= 0.0f)
+	{
+		SmoothedGameThreadMs = GameThreadMs;
+		SmoothedAIMs = AIMs;
+	}
+	else
+	{
+		SmoothedGameThreadMs = FMath::Lerp(SmoothedGameThreadMs, GameThreadMs, FrameCostSmoothing);
+		SmoothedAIMs = FMath::Lerp(SmoothedAIMs, AIMs, FrameCostSmoothing);
+	}
+
+	TimeSinceCapAdjustment += DeltaTime;
+	if (TimeSinceCapAdjustment < AdaptiveCapInterval)
+	{
+		return;
+	}
+	TimeSinceCapAdjustment = 0.0f;
+
+	const int32 PreviousCap = AdaptiveZombieCap;
+	const bool bOverBudget = SmoothedGameThreadMs > GameThreadBudgetMs * LowerCapAboveBudgetFraction
+		|| SmoothedAIMs > AIBudgetMs * LowerCapAboveBudgetFraction;
+	const bool bUnderBudget = SmoothedGameThreadMs < GameThreadBudgetMs * RaiseCapBelowBudgetFraction
+		&& SmoothedAIMs < AIBudgetMs * RaiseCapBelowBudgetFraction;
+
+	if (bOverBudget)
+	{
+		AdaptiveZombieCap -= AdaptiveCapStep;
+	}
+	else if (bUnderBudget && ActiveZombies.Num() >= AdaptiveZombieCap)
+	{
+		// Only raise while the cap is actually limiting the horde, otherwise the cost sample says nothing about the new density
+		AdaptiveZombieCap += AdaptiveCapStep;
+	}
+
+	AdaptiveZombieCap = FMath::Clamp(AdaptiveZombieCap, MinAdaptiveZombieCap, MaxAdaptiveZombieCap);
+
+	if (AdaptiveZombieCap != PreviousCap)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ZombieSpawnManager: Adaptive cap %d -> %d (GT %.2fms / %.2fms, AI %.2fms / %.2fms)"),
+			PreviousCap, AdaptiveZombieCap, SmoothedGameThreadMs, GameThreadBudgetMs, SmoothedAIMs, AIBudgetMs);
+	}
+}
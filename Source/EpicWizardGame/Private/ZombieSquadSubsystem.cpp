@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ZombieSquadSubsystem.h"
+#include "ZombieAIController.h"
+#include "GameFramework/Pawn.h"
+
+bool UZombieSquadSubsystem::JoinOrFormSquad(AZombieAIController* Controller, AActor* Target, float JoinRadius, int32 MaxSquadSize)
+{
+	if (!Controller || !Target || !Controller->GetPawn() || IsInSquad(Controller))
+	{
+		return false;
+	}
+
+	const FVector Location = Controller->GetPawn()->GetActorLocation();
+	const float JoinRadiusSq = FMath::Square(JoinRadius);
+
+	// Look for a leader close by that is already heading for the same target
+	for (TPair<int32, FZombieSquad>& Pair : Squads)
+	{
+		FZombieSquad& Squad = Pair.Value;
+		const AZombieAIController* Leader = Squad.Leader.Get();
+		if (!Leader || !Leader->GetPawn() || Leader->GetCurrentTarget() != Target)
+		{
+			continue;
+		}
+
+		if (Squad.Followers.Num() + 1 >= MaxSquadSize)
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Location, Leader->GetPawn()->GetActorLocation()) > JoinRadiusSq)
+		{
+			continue;
+		}
+
+		Squad.Followers.Add(Controller);
+		SquadIds.Add(Controller, Pair.Key);
+		return true;
+	}
+
+	// Nobody to follow - lead a new squad that later zombies can join
+	const int32 SquadId = NextSquadId++;
+	FZombieSquad& NewSquad = Squads.Add(SquadId);
+	NewSquad.Leader = Controller;
+	SquadIds.Add(Controller, SquadId);
+
+	return false;
+}
+
+void UZombieSquadSubsystem::LeaveSquad(AZombieAIController* Controller)
+{
+	int32 SquadId = INDEX_NONE;
+	if (!SquadIds.RemoveAndCopyValue(Controller, SquadId))
+	{
+		return;
+	}
+
+	FZombieSquad* Squad = Squads.Find(SquadId);
+	if (!Squad)
+	{
+		return;
+	}
+
+	Squad->Followers.Remove(Controller);
+	Squad->Followers.RemoveAll([](const TWeakObjectPtr<AZombieAIController>& Follower)
+	{
+		return !Follower.IsValid();
+	});
+
+	if (Squad->Leader.Get() == Controller)
+	{
+		// Promote the first follower; it resumes target scoring on its next update
+		if (Squad->Followers.Num() > 0)
+		{
+			Squad->Leader = Squad->Followers[0];
+			Squad->Followers.RemoveAt(0);
+		}
+		else
+		{
+			Squads.Remove(SquadId);
+		}
+	}
+}
+
+AZombieAIController* UZombieSquadSubsystem::GetSquadLeader(const AZombieAIController* Controller) const
+{
+	const int32* SquadId = SquadIds.Find(Controller);
+	if (!SquadId)
+	{
+		return nullptr;
+	}
+
+	const FZombieSquad* Squad = Squads.Find(*SquadId);
+	if (!Squad)
+	{
+		return nullptr;
+	}
+
+	AZombieAIController* Leader = Squad->Leader.Get();
+	return Leader != Controller ? Leader : nullptr;
+}
+
+bool UZombieSquadSubsystem::GetFormationLocation(const AZombieAIController* Controller, float Spacing, FVector& OutLocation) const
+{
+	const int32* SquadId = SquadIds.Find(Controller);
+	const FZombieSquad* Squad = SquadId ? Squads.Find(*SquadId) : nullptr;
+	if (!Squad)
+	{
+		return false;
+	}
+
+	const AZombieAIController* Leader = Squad->Leader.Get();
+	const APawn* LeaderPawn = Leader ? Leader->GetPawn() : nullptr;
+	const int32 FollowerIndex = Squad->Followers.IndexOfByKey(Controller);
+	if (!LeaderPawn || FollowerIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Face along the leader's movement so followers fall in behind it on its corridor
+	FVector Forward = LeaderPawn->GetVelocity().GetSafeNormal2D();
+	if (Forward.IsNearlyZero())
+	{
+		Forward = LeaderPawn->GetActorForwardVector().GetSafeNormal2D();
+	}
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, Forward);
+
+	// Rows of three: centre, left, right
+	static const float ColumnOffsets[] = { 0.0f, -1.0f, 1.0f };
+	const int32 Row = FollowerIndex / 3 + 1;
+	const float Column = ColumnOffsets[FollowerIndex % 3];
+
+	OutLocation = LeaderPawn->GetActorLocation() - Forward * (Row * Spacing) + Right * (Column * Spacing);
+	return true;
+}
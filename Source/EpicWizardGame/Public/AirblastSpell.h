@@ -26,7 +26,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float KnockbackForce = 2000.0f;
 
-	/** Projectile class to spawn for the airblast */
+	/** Actor to spawn for the airblast; left as plain AActor, the pooled cosmetic visual is used instead */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	TSubclassOf<AActor> ProjectileClass;
 
@@ -38,5 +38,5 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float ProjectileLifetime = 1.0f;
 
-	virtual void Execute(AWizardCharacter* Caster) override;
+	virtual bool Execute(AWizardCharacter* Caster) override;
 };
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AttackSlotComponent.generated.h"
+
+class UBoxComponent;
+
+/**
+ * Publishes a ring of attack positions around a structure's attack box.
+ * Zombies reserve a slot before closing in and wait in a queue when the ring is full.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class EPICWIZARDGAME_API UAttackSlotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Distance between neighbouring slots along the ring */
+	UPROPERTY(EditAnywhere, Category="Attack Slots", meta=(ClampMin="10.0"))
+	float SlotSpacing = 90.0f;
+
+	/** How far inside the attack box edge the ring sits (keeps attackers overlapping the box) */
+	UPROPERTY(EditAnywhere, Category="Attack Slots", meta=(ClampMin="0.0"))
+	float SlotInset = 30.0f;
+
+	/** Fewest slots the ring will publish */
+	UPROPERTY(EditAnywhere, Category="Attack Slots", meta=(ClampMin="1"))
+	int32 MinSlots = 4;
+
+	/** Most slots the ring will publish */
+	UPROPERTY(EditAnywhere, Category="Attack Slots", meta=(ClampMin="1"))
+	int32 MaxSlots = 32;
+
+	/** Distance outside the attack box where queued attackers wait */
+	UPROPERTY(EditAnywhere, Category="Attack Slots", meta=(ClampMin="0.0"))
+	float QueueDistance = 250.0f;
+
+public:
+
+	UAttackSlotComponent();
+
+	/** Build the slot ring from the structure's attack box */
+	void InitializeFromBox(UBoxComponent* Box);
+
+	/** Reserve a slot for an attacker. Returns the slot index, or INDEX_NONE if the attacker was queued */
+	int32 ReserveSlot(AActor* Attacker);
+
+	/** Give back a slot (or leave the queue) */
+	void ReleaseSlot(AActor* Attacker);
+
+	/** World location of a slot */
+	FVector GetSlotLocation(int32 SlotIndex) const;
+
+	/** World location where a queued attacker should wait */
+	FVector GetQueueLocation(const AActor* Attacker) const;
+
+	/** Number of slots in the ring */
+	UFUNCTION(BlueprintPure, Category="Attack Slots")
+	int32 GetNumSlots() const { return LocalSlotOffsets.Num(); }
+
+	/** Number of attackers waiting for a slot */
+	UFUNCTION(BlueprintPure, Category="Attack Slots")
+	int32 GetQueueLength() const { return WaitQueue.Num(); }
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	/** Returns the slot currently held by an attacker */
+	int32 FindSlotOwnedBy(const AActor* Attacker) const;
+
+	/** Drop stale attackers from the slots and queue */
+	void PruneInvalidAttackers();
+
+	/** Box the ring was built from */
+	TWeakObjectPtr<UBoxComponent> SlotBox;
+
+	/** Slot positions in the box's unscaled XY plane */
+	TArray<FVector2D> LocalSlotOffsets;
+
+	/** Attacker holding each slot */
+	TArray<TWeakObjectPtr<AActor>> SlotOwners;
+
+	/** Attackers waiting for a slot, in arrival order */
+	TArray<TWeakObjectPtr<AActor>> WaitQueue;
+};
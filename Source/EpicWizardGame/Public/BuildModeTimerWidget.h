@@ -11,6 +11,7 @@ class UTextBlock;
 
 /**
  * Giant countdown timer displayed in the center of screen during build mode
+ * Updates from gameplay events rather than ticking; text only changes once per second
  */
 UCLASS()
 class EPICWIZARDGAME_API UBuildModeTimerWidget : public UUserWidget
@@ -21,7 +22,6 @@ public:
 	UBuildModeTimerWidget(const FObjectInitializer& ObjectInitializer);
 
 	virtual void NativeConstruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	virtual void NativeDestruct() override;
 
 	/** Text block for displaying the countdown (bind this in BP) */
@@ -43,6 +43,13 @@ protected:
 	/** Find the wave manager in the level */
 	void FindWaveManager();
 
-	/** Update the timer display */
-	void UpdateTimer();
+	/** Show the countdown for the given whole seconds */
+	void OnBuildModeSecondElapsed(int32 SecondsRemaining);
+
+	/** Clear the countdown when a wave starts */
+	void OnWaveStarted(int32 Wave);
+
+	/** Event bus subscriptions */
+	FDelegateHandle BuildModeSecondHandle;
+	FDelegateHandle WaveStartedHandle;
 };
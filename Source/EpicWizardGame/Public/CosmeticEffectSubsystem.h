@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CosmeticEffectSubsystem.generated.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+class UMaterialInterface;
+
+/** Kind of visual, picks the default scale when the descriptor doesn't override it */
+UENUM()
+enum class ECosmeticEffectType : uint8
+{
+	LightningBolt,
+	Airblast,
+	Count UMETA(Hidden)
+};
+
+/** Everything needed to play one visual-only effect */
+struct FCosmeticEffectDesc
+{
+	ECosmeticEffectType Type = ECosmeticEffectType::LightningBolt;
+
+	/** Where the effect starts */
+	FVector Location = FVector::ZeroVector;
+
+	/** Travel direction, and facing unless Rotation is set */
+	FVector Direction = FVector::ForwardVector;
+
+	/** Facing override, for visual tweaks that shouldn't bend the path */
+	TOptional<FRotator> Rotation;
+
+	/** Travel speed (units/s); 0 keeps it in place */
+	float Speed = 0.0f;
+
+	/** Seconds before the effect is returned to the pool */
+	float Duration = 1.0f;
+
+	/** Mesh override; the type's default is used when null */
+	UStaticMesh* Mesh = nullptr;
+
+	/** Material override for slot 0 */
+	UMaterialInterface* Material = nullptr;
+
+	/** Scale override; the type's default is used when unset */
+	TOptional<FVector> Scale;
+
+	/** Take mesh, material and scale from the first static mesh component of an actor (usually a class default object) */
+	void CopyAppearanceFrom(const AActor* Template);
+};
+
+/**
+ * Plays visual-only effects (lightning bolts, airblast sweeps) from pooled, non-colliding mesh components,
+ * so gameplay code never spawns actors just to show something. Not created on dedicated servers or
+ * when the process can't render, and compiled out of server builds; callers skip the visual when
+ * there is no subsystem.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UCosmeticEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Effects playing at once; further requests are dropped until one finishes */
+	static constexpr int32 MaxActiveEffects = 128;
+
+	/** Play an effect. Returns false if it was dropped */
+	bool PlayEffect(const FCosmeticEffectDesc& Desc);
+
+	/** Effects currently playing */
+	int32 GetActiveEffectCount() const { return ActiveEffects.Num(); }
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** One playing effect */
+	struct FActiveEffect
+	{
+		UStaticMeshComponent* Component = nullptr;
+		FVector Velocity = FVector::ZeroVector;
+		float RemainingTime = 0.0f;
+	};
+
+	/** Take a hidden component from the pool, creating one if the pool is empty */
+	UStaticMeshComponent* AcquireComponent();
+
+	/** Hide a component and put it back in the pool */
+	void ReleaseComponent(UStaticMeshComponent* Component);
+
+	TArray<FActiveEffect> ActiveEffects;
+
+	/** Hidden components ready for reuse */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStaticMeshComponent>> FreeComponents;
+
+	/** Every component we've created, so the pool is kept alive */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStaticMeshComponent>> AllComponents;
+
+	/** Actor that owns the pooled components; spawned on first use */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> EffectHost;
+
+	/** Mesh used when the descriptor doesn't set one */
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> DefaultMesh;
+};
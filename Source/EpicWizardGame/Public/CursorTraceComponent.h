@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "CursorTraceComponent.generated.h"
+
+/** What the cursor was pointing at */
+struct FCursorTraceResult
+{
+	/** True if the trace hit something */
+	bool bValid = false;
+
+	/** True if the ray came from the mouse cursor, false if it fell back to the camera centre */
+	bool bFromCursor = false;
+
+	/** Ray the trace was run along */
+	FVector RayOrigin = FVector::ZeroVector;
+	FVector RayDirection = FVector::ForwardVector;
+
+	/** Hit point, only meaningful when bValid */
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	/** Actor that was hit */
+	TWeakObjectPtr<AActor> HitActor;
+
+	/** GFrameCounter of the frame the ray was built on */
+	uint64 FrameNumber = 0;
+};
+
+/**
+ * Traces under the mouse cursor at most once per frame and shares the result.
+ * Aiming and turret placement both read from here instead of running their own traces.
+ * In async mode the trace result lags one frame behind, but the game thread never waits on it.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class EPICWIZARDGAME_API UCursorTraceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UCursorTraceComponent();
+
+	/** This frame's cursor trace, running it first if nobody has asked yet this frame */
+	const FCursorTraceResult& GetCursorHit();
+
+	/** This frame's cursor ray, without needing the trace result */
+	bool GetCursorRay(FVector& OutOrigin, FVector& OutDirection);
+
+	/** Use this ray instead of the mouse until cleared; input replays drive aiming through it */
+	void SetRayOverride(const FVector& Origin, const FVector& Direction);
+
+	void ClearRayOverride() { bHasRayOverride = false; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+
+	virtual void BeginPlay() override;
+
+	/** Channel the cursor trace runs on */
+	UPROPERTY(EditAnywhere, Category="Cursor Trace")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	/** Length of the cursor trace */
+	UPROPERTY(EditAnywhere, Category="Cursor Trace", meta=(ClampMin="0.0"))
+	float TraceDistance = 100000.0f;
+
+	/** Run the trace asynchronously; results are one frame old */
+	UPROPERTY(EditAnywhere, Category="Cursor Trace")
+	bool bUseAsyncTrace = false;
+
+private:
+
+	/** Build this frame's ray from the mouse, or the camera centre if there is no mouse */
+	void UpdateRay();
+
+	/** Run the synchronous trace for this frame */
+	void UpdateTrace();
+
+	/** Collision params shared by the sync and async traces */
+	FCollisionQueryParams MakeQueryParams() const;
+
+	void OnAsyncTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	FCursorTraceResult Result;
+
+	bool bHasRayOverride = false;
+	FVector RayOverrideOrigin = FVector::ZeroVector;
+	FVector RayOverrideDirection = FVector::ForwardVector;
+
+	/** Frame the trace last ran on (sync mode) */
+	uint64 TraceFrame = MAX_uint64;
+
+	FTraceDelegate AsyncTraceDelegate;
+};
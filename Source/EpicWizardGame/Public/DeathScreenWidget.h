@@ -8,7 +8,8 @@
 
 /**
  * Minimal death screen UI that displays a message and a "Try Again" button.
- * The button returns the player to the TitleScreen level.
+ * The button runs OnTryAgain when bound (in-world restart), otherwise it returns the player to the TitleScreen level.
+ * A second "Retry Wave" button is shown only while OnRetryWave is bound.
  */
 UCLASS()
 class EPICWIZARDGAME_API UDeathScreenWidget : public UUserWidget
@@ -18,9 +19,17 @@ class EPICWIZARDGAME_API UDeathScreenWidget : public UUserWidget
 public:
 	UDeathScreenWidget(const FObjectInitializer& ObjectInitializer);
 
+	/** Called instead of opening the TitleScreen when the death UI is shown as an overlay */
+	FSimpleDelegate OnTryAgain;
+
+	/** Rolls back to the start of the lost wave; the button is hidden while unbound */
+	FSimpleDelegate OnRetryWave;
+
 protected:
 	virtual TSharedRef<SWidget> RebuildWidget() override;
 
 private:
 	FReply HandleTryAgainClicked();
+
+	FReply HandleRetryWaveClicked();
 };
@@ -28,5 +28,5 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float SpawnDistance = 100.0f;
 
-	virtual void Execute(AWizardCharacter* Caster) override;
+	virtual bool Execute(AWizardCharacter* Caster) override;
 };
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEventBus.generated.h"
+
+class AZombieCharacter;
+class ATurret;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnZombieDiedEvent, AZombieCharacter* /*Zombie*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWaveStartedEvent, int32 /*Wave*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWaveCompletedEvent, int32 /*Wave*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMoneyChangedEvent, int32 /*NewMoney*/, int32 /*Delta*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBuildModeSecondElapsedEvent, int32 /*SecondsRemaining*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTurretPlacedEvent, ATurret* /*Turret*/, int32 /*Cost*/);
+DECLARE_MULTICAST_DELEGATE(FOnNavMeshRebuiltEvent);
+DECLARE_MULTICAST_DELEGATE(FOnRunLostEvent);
+DECLARE_MULTICAST_DELEGATE(FOnRunRestartedEvent);
+
+/**
+ * Native gameplay event bus for the current world.
+ * Game code broadcasts typed events here so UI and managers can react instead of polling every frame.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UGameplayEventBus : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Convenience accessor, returns nullptr if the world has no bus */
+	static UGameplayEventBus* Get(const UObject* WorldContextObject);
+
+	/** A zombie just died (it is still valid and IsDead() is true) */
+	FOnZombieDiedEvent OnZombieDied;
+
+	/** A wave started spawning */
+	FOnWaveStartedEvent OnWaveStarted;
+
+	/** Every zombie of a wave is dead; build mode follows */
+	FOnWaveCompletedEvent OnWaveCompleted;
+
+	/** Player money changed */
+	FOnMoneyChangedEvent OnMoneyChanged;
+
+	/** Build mode countdown ticked over to a new whole second */
+	FOnBuildModeSecondElapsedEvent OnBuildModeSecondElapsed;
+
+	/** The player placed a turret */
+	FOnTurretPlacedEvent OnTurretPlaced;
+
+	/** Navmesh tiles dirtied by turret obstacles finished rebuilding; cached paths are stale */
+	FOnNavMeshRebuiltEvent OnNavMeshRebuilt;
+
+	/** The wizard died or the tower fell; the run is over until it is restarted */
+	FOnRunLostEvent OnRunLost;
+
+	/** The world was reset in place for a fresh run */
+	FOnRunRestartedEvent OnRunRestarted;
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayRandomSubsystem.generated.h"
+
+/** Independent random streams, so one system drawing more numbers doesn't shift another's */
+UENUM()
+enum class EGameplayRandomStream : uint8
+{
+	/** Per-wave spawn seeds */
+	Waves,
+	/** Spawn manager setup before the first wave */
+	ZombieSpawning,
+	/** Weapon spread */
+	Weapons,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Seeded random streams for gameplay code.
+ * Every stream derives from one run seed, logged at startup and settable with -RandomSeed=<n>
+ * (input replays set it too), so a run can be reproduced exactly. Gameplay code should draw from
+ * here instead of FMath::Rand.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UGameplayRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Convenience accessor, returns nullptr if the world has no subsystem */
+	static UGameplayRandomSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Reseed every stream from a new run seed */
+	void SetRunSeed(int32 NewRunSeed);
+
+	int32 GetRunSeed() const { return RunSeed; }
+
+	/** Stream for one system */
+	FRandomStream& GetStream(EGameplayRandomStream Stream) { return Streams[static_cast<uint8>(Stream)]; }
+
+	/** Draw a fresh seed from a stream, for seeding a per-actor FRandomStream */
+	int32 NextSeed(EGameplayRandomStream Stream) { return static_cast<int32>(GetStream(Stream).GetUnsignedInt()); }
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+protected:
+
+	int32 RunSeed = 0;
+
+	FRandomStream Streams[static_cast<uint8>(EGameplayRandomStream::Count)];
+};
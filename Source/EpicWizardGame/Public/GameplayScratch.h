@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/** Array for per-call query results, allocated linearly from the game thread's FMemStack */
+template<typename ElementType>
+using TScratchArray = TArray<ElementType, TMemStackAllocator<>>;
+
+/**
+ * Marks the game thread's FMemStack and pops it when the scope ends, freeing every TScratchArray
+ * allocated inside in one step. Declare it before the scratch arrays it covers.
+ * Scopes and bytes per frame show up in stat GameplayScratch.
+ */
+class EPICWIZARDGAME_API FGameplayScratchScope
+{
+public:
+
+	FGameplayScratchScope();
+
+	~FGameplayScratchScope();
+
+	UE_NONCOPYABLE(FGameplayScratchScope);
+
+private:
+
+	FMemMark Mark;
+
+	/** Stack usage when the scope opened */
+	int32 StartByteCount = 0;
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTimerWheel.h"
+#include "GameplayTimerSubsystem.generated.h"
+
+/** What a gameplay timer is for, counted separately in stat GameplayTimers */
+UENUM()
+enum class EGameplayTimerCategory : uint8
+{
+	ZombieAI,
+	ZombieAnimation,
+	ZombieDeath,
+	StatusEffect,
+	ProjectileLifetime,
+	AreaEffect,
+	Other,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Timer service for the high-volume gameplay timers (per zombie, per projectile, per hit).
+ * Backed by a hierarchical timing wheel so scheduling and clearing stay O(1) as the horde grows,
+ * and everything due in a step fires in one batch. Advanced by USimulationStepSubsystem, so timers
+ * run on fixed simulation time and stop while the game is paused. Repeating timers bound to an
+ * object end by themselves once that object is destroyed.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UGameplayTimerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Length of one wheel tick (seconds); delays are rounded up to whole ticks */
+	static constexpr double TickInterval = 1.0 / 120.0;
+
+	/** Schedule Callback after Delay seconds, and every Delay seconds after that when looping */
+	FGameplayTimerHandle SetTimer(EGameplayTimerCategory Category, float Delay, FSimpleDelegate Callback, bool bLoop = false);
+
+	/** Cancel a timer and reset the handle */
+	void ClearTimer(FGameplayTimerHandle& Handle);
+
+	/** Is the timer still pending */
+	bool IsTimerActive(const FGameplayTimerHandle& Handle) const { return Wheel.IsActive(Handle); }
+
+	/** Seconds until the timer fires, or -1 if it isn't pending */
+	float GetTimerRemaining(const FGameplayTimerHandle& Handle) const;
+
+	/** Destroy an actor after LifeSpan seconds; the wheel-backed equivalent of AActor::SetLifeSpan */
+	void SetActorLifeSpan(AActor* Actor, float LifeSpan, EGameplayTimerCategory Category = EGameplayTimerCategory::ProjectileLifetime);
+
+	/** Pending timers in a category */
+	int32 GetActiveTimerCount(EGameplayTimerCategory Category) const { return Wheel.GetActiveCount(static_cast<uint8>(Category)); }
+
+	/** Fire everything due within the next StepSeconds of simulation time */
+	void AdvanceSimulation(float StepSeconds);
+
+protected:
+
+	FGameplayTimerWheel Wheel;
+
+	/** Simulation seconds the wheel has been advanced through */
+	double ElapsedTime = 0.0;
+};
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Identifies a timer in an FGameplayTimerWheel; stale once the timer fires (one-shot) or is cleared */
+struct FGameplayTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Hierarchical timing wheel.
+ * Time advances in fixed ticks. Level 0 has one slot per tick for the next 256 ticks; each higher level
+ * covers 64 slots of the level below and is cascaded down as time reaches it. Insert and cancel are O(1)
+ * (timers live in a pooled array and are linked into slot lists by index), and advancing costs one slot
+ * per elapsed tick plus the occasional cascade, independent of how many timers are pending.
+ */
+class EPICWIZARDGAME_API FGameplayTimerWheel
+{
+public:
+
+	FGameplayTimerWheel();
+
+	/** Schedule a timer DelayTicks from now (at least 1). IntervalTicks > 0 makes it repeat */
+	FGameplayTimerHandle Add(uint64 DelayTicks, uint32 IntervalTicks, uint8 Category, FSimpleDelegate&& Callback);
+
+	/** Cancel a timer and reset the handle. Safe on stale handles */
+	void Remove(FGameplayTimerHandle& Handle);
+
+	/** Is the handle's timer still pending */
+	bool IsActive(const FGameplayTimerHandle& Handle) const;
+
+	/** Ticks until the timer fires, or -1 if it isn't pending */
+	int64 GetRemainingTicks(const FGameplayTimerHandle& Handle) const;
+
+	/**
+	 * Advance to TargetTick and run everything that expired, in expiry order.
+	 * Repeating timers are rescheduled before their callback runs; repeating timers whose callback
+	 * is no longer bound (its object is gone) are dropped. Returns the number of callbacks run.
+	 */
+	int32 Advance(uint64 TargetTick);
+
+	/** Current tick */
+	uint64 GetCurrentTick() const { return CurrentTick; }
+
+	/** Pending timers in a category */
+	int32 GetActiveCount(uint8 Category) const { return ActiveCounts.IsValidIndex(Category) ? ActiveCounts[Category] : 0; }
+
+	/** Pending timers in all categories */
+	int32 GetTotalActiveCount() const { return NumActive; }
+
+private:
+
+	static constexpr int32 Level0Bits = 8;
+	static constexpr int32 LevelNBits = 6;
+	static constexpr int32 NumUpperLevels = 3;
+	static constexpr int32 Level0Slots = 1 << Level0Bits;
+	static constexpr int32 LevelNSlots = 1 << LevelNBits;
+	static constexpr uint64 MaxDelayTicks = (uint64(1) << (Level0Bits + NumUpperLevels * LevelNBits)) - 1;
+
+	struct FNode
+	{
+		FSimpleDelegate Callback;
+		uint64 ExpireTick = 0;
+		uint32 IntervalTicks = 0;
+		uint32 Serial = 1;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		/** Slot list this node is linked into, INDEX_NONE while unlinked */
+		int32 Slot = INDEX_NONE;
+		uint8 Category = 0;
+		bool bActive = false;
+	};
+
+	/** Link a node into the slot matching its expiry */
+	void Link(int32 NodeIndex);
+
+	/** Unlink a node from its slot list */
+	void Unlink(int32 NodeIndex);
+
+	/** Return a node to the pool, bumping its serial so old handles go stale */
+	void Release(int32 NodeIndex);
+
+	/** Re-link every node in an upper level slot, which drops them into lower levels */
+	void Cascade(int32 Slot);
+
+	/** Pooled timer storage */
+	TArray<FNode> Nodes;
+
+	/** Unused node indices */
+	TArray<int32> FreeNodes;
+
+	/** Head node of each slot list: level 0 slots first, then each upper level */
+	int32 SlotHeads[Level0Slots + NumUpperLevels * LevelNSlots];
+
+	/** Pending timers per category */
+	TArray<int32, TInlineAllocator<8>> ActiveCounts;
+
+	/** Expired node indices and serials for the current Advance */
+	TArray<TPair<int32, uint32>> ExpiredScratch;
+
+	uint64 CurrentTick = 0;
+
+	int32 NumActive = 0;
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HealthBarSubsystem.generated.h"
+
+/** One floating health bar drawn by SHealthBarOverlay */
+struct FHealthBarEntry
+{
+	/** Actor the bar floats over */
+	TWeakObjectPtr<AActor> Owner;
+
+	/** Height above the actor origin */
+	float VerticalOffset = 100.0f;
+
+	/** Bar size in screen units */
+	FVector2D Size = FVector2D(100.0f, 10.0f);
+
+	/** Current HP ratio (0-1), pushed by the owner */
+	float HealthPercent = 1.0f;
+};
+
+/**
+ * Registry of floating health bars.
+ * Actors push their HP ratio on change; a single HUD overlay draws every bar in one paint pass.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UHealthBarSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Add a bar over an actor. Returns the handle to update or remove it with */
+	int32 RegisterHealthBar(AActor* Owner, float VerticalOffset, const FVector2D& Size);
+
+	/** Remove a bar and reset the handle */
+	void UnregisterHealthBar(int32& Handle);
+
+	/** Update a bar's HP ratio */
+	void SetHealthPercent(int32 Handle, float HealthPercent);
+
+	/** All registered bars */
+	const TSparseArray<FHealthBarEntry>& GetEntries() const { return Entries; }
+
+private:
+
+	/** Bars by handle; sparse so handles stay stable as bars come and go */
+	TSparseArray<FHealthBarEntry> Entries;
+};
@@ -4,11 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "SpellbookComponent.h"
 #include "HotbarWidget.generated.h"
 
 class UBorder;
 class UImage;
 class UTexture2D;
+class AWaveManager;
+class ATurretPlacementGrid;
+class ATurretGhost;
+class ATurret;
 
 UENUM(BlueprintType)
 enum class EHotbarMode : uint8
@@ -124,9 +129,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hotbar|Economy")
 	TArray<int32> TurretCosts;
 
-	/** Preview turret actor (spawned when in turret mode) */
+	/** Placement preview, spawned the first time turret mode is used and reused for every turret class */
 	UPROPERTY(BlueprintReadOnly, Category="Hotbar|Preview")
-	ATurret* PreviewTurret;
+	ATurretGhost* PreviewGhost;
+
+	/** Deprecated: the preview is PreviewGhost, a mesh-only actor. Always null; kept for one release so Blueprints reading it still compile */
+	UPROPERTY(BlueprintReadOnly, Category="Hotbar|Preview", meta=(DeprecatedProperty, DeprecationMessage="The placement preview is PreviewGhost now; this is always None"))
+	ATurret* PreviewTurret = nullptr;
 
 	/** Material to apply to preview turret (make it translucent) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Hotbar|Preview")
@@ -160,9 +169,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Hotbar")
 	void SelectSlotByNumber(int32 SlotNumber);
 
-	/** Use the currently selected hotbar slot */
+	/** Use the currently selected hotbar slot. Returns the spell cast result, NoSpell for the mode toggle and turret placement */
 	UFUNCTION(BlueprintCallable, Category="Hotbar")
-	void UseCurrentSlot();
+	ESpellCastResult UseCurrentSlot();
 
 	/** Use a specific hotbar slot (handles mode toggle and turret placement automatically) */
 	UFUNCTION(BlueprintCallable, Category="Hotbar")
@@ -234,17 +243,55 @@ protected:
 	/** Update preview turret position and visibility */
 	void UpdatePreviewTurret();
 
-	/** Spawn or update preview turret for current slot */
-	void SpawnPreviewTurret();
+	/** Hide the placement preview */
+	void HidePreviewTurret();
 
-	/** Destroy preview turret */
+	/** Destroy the placement preview and its pooled meshes */
 	void DestroyPreviewTurret();
 
 	/** Raycast to find a valid turret placement location */
 	bool GetTurretPlacementHit(FHitResult& OutHitResult) const;
 
+	/** Ray used for turret placement (cursor, or camera centre as fallback) */
+	bool GetTurretPlacementRay(FVector& OutOrigin, FVector& OutDirection) const;
+
+	/** Where a turret would go right now; snapped to the placement grid when the level has one */
+	bool GetTurretPlacementLocation(FVector& OutLocation) const;
+
+	/** Returns the level's turret placement grid, looked up once and cached */
+	ATurretPlacementGrid* GetPlacementGrid() const;
+
+	/** Returns the level's wave manager, looked up once and cached */
+	AWaveManager* GetWaveManager() const;
+
+	/** Build mode ends when a wave starts */
+	void OnWaveStarted(int32 Wave);
+
+	/** Build mode begins when a wave completes */
+	void OnWaveCompleted(int32 Wave);
+
 private:
 
 	/** Clamp slot index to valid range */
 	int32 ClampSlotIndex(int32 Index) const;
+
+	/** Cached wave manager */
+	mutable TWeakObjectPtr<AWaveManager> CachedWaveManager;
+
+	/** Cached placement grid */
+	mutable TWeakObjectPtr<ATurretPlacementGrid> CachedPlacementGrid;
+
+	/** The level was searched for these; both are placed in the level, so one search is enough even when it has none */
+	mutable bool bLookedUpWaveManager = false;
+	mutable bool bLookedUpPlacementGrid = false;
+
+	/** Grid cell the preview was last moved to; the preview only updates when this changes */
+	FIntPoint LastPreviewCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	/** Build mode state, kept current by wave events */
+	bool bBuildModeActive = false;
+
+	/** Event bus subscriptions */
+	FDelegateHandle WaveStartedHandle;
+	FDelegateHandle WaveCompletedHandle;
 };
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What a replay frame carries; only flagged fields are stored */
+enum class EInputReplayFlags : uint8
+{
+	None = 0,
+	/** Move input changed */
+	Move = 1 << 0,
+	/** Control rotation (first-person aim) changed */
+	ControlRotation = 1 << 1,
+	/** Cursor ray (top-down aim and turret placement) changed */
+	CursorRay = 1 << 2,
+	/** Cast button held on this step; a state, not a change */
+	CastHeld = 1 << 3,
+	/** A hotbar slot was picked by number */
+	HotbarSlot = 1 << 4,
+	/** The hotbar was scrolled */
+	HotbarScroll = 1 << 5,
+};
+ENUM_CLASS_FLAGS(EInputReplayFlags);
+
+/** Wizard input on one simulation step. Frames are only written for steps where something changed */
+struct FInputReplayFrame
+{
+	/** Simulation step the input applies to */
+	uint32 Step = 0;
+
+	EInputReplayFlags Flags = EInputReplayFlags::None;
+
+	/** Held move input, -1..1 per axis */
+	FVector2D Move = FVector2D::ZeroVector;
+
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	FVector CursorOrigin = FVector::ZeroVector;
+	FVector CursorDirection = FVector::ForwardVector;
+
+	/** Hotbar slot number (1-5) */
+	int32 HotbarSlot = 0;
+
+	/** Scroll direction, only the sign matters */
+	float HotbarScroll = 0.0f;
+};
+
+/**
+ * Recorded wizard input plus everything needed to replay it: the map, the run seed and the
+ * simulation rate. Stored compactly: step deltas are packed, move is quantized to a byte per axis
+ * and aim to 16 bits per axis.
+ */
+struct EPICWIZARDGAME_API FInputReplay
+{
+	/** Bumped whenever the layout changes; older files are rejected */
+	static constexpr int32 CurrentVersion = 1;
+
+	FString MapName;
+
+	int32 RunSeed = 0;
+
+	float StepRate = 30.0f;
+
+	TArray<FInputReplayFrame> Frames;
+
+	/** Write to a file */
+	bool SaveToFile(const FString& FilePath);
+
+	/** Read from a file, returns false on a bad magic, version or truncated data */
+	bool LoadFromFile(const FString& FilePath);
+
+private:
+
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InputReplay.h"
+#include "InputReplaySubsystem.generated.h"
+
+class AWizardCharacter;
+class UEnhancedInputComponent;
+struct FInputActionValue;
+
+/**
+ * Records the wizard's input (move, aim, cast, hotbar, and through the cursor ray, turret placement)
+ * against simulation steps, together with the run seed, and plays it back.
+ *
+ * -RecordReplay=<name> writes Saved/InputReplays/<name>.wrpl when the level ends.
+ * -PlayReplay=<name> drives the wizard from the file with a fixed frame time of one simulation step,
+ * so a headless run (-nullrhi) gives the same zombie spawns and turret decisions every time.
+ * Add -ExitAfterReplay to quit when the input runs out. Both modes log the step each wave starts on,
+ * so two runs can be diffed.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UInputReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	bool IsRecording() const { return bRecording; }
+
+	bool IsPlaying() const { return bPlaying; }
+
+	/** Where replays are read from and written to */
+	static FString GetReplayDir();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Resolve a replay name from the command line to a file path */
+	static FString ResolveReplayPath(const FString& Name);
+
+	void StartRecording(const FString& FilePath, const FString& MapName);
+
+	void StartPlayback(const FString& FilePath, const FString& MapName);
+
+	/** Write the recording out */
+	void FinishRecording();
+
+	/** Make sure we're hooked into the current wizard's input (the pawn can change on restart) */
+	AWizardCharacter* BindWizard();
+
+	/** Recording: turn the input seen since the last step into a frame */
+	void RecordStep(float StepSeconds);
+
+	/** Playback: feed the wizard the input for the step this frame is about to run */
+	void OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Apply the changes in one recorded frame to the playback state */
+	void ApplyFrame(const FInputReplayFrame& Frame, AWizardCharacter* Wizard);
+
+	void FinishPlayback();
+
+	/** Put the engine's fixed time step back the way playback found it */
+	void RestoreFixedTimeStep();
+
+	void OnWaveStarted(int32 Wave);
+
+	void OnZombieDied(class AZombieCharacter* Zombie);
+
+	FInputReplay Replay;
+
+	FString ReplayPath;
+
+	bool bRecording = false;
+
+	bool bPlaying = false;
+
+	/** Quit once playback runs out of input */
+	bool bExitAfterReplay = false;
+
+	/** Playback switched the engine to a fixed time step; the previous setting is below */
+	bool bOverrodeFixedTimeStep = false;
+	bool bPrevUseFixedTimeStep = false;
+	double PrevFixedDeltaTime = 0.0;
+
+	/** Wizard whose input component we bound for recording */
+	TWeakObjectPtr<AWizardCharacter> BoundWizard;
+
+	TWeakObjectPtr<UEnhancedInputComponent> BoundInputComponent;
+
+	TArray<uint32> InputBindingHandles;
+
+	/** Input state, live while recording and reconstructed from frames during playback */
+	FVector2D HeldMove = FVector2D::ZeroVector;
+	bool bCastHeld = false;
+
+	/** One-shot events since the last recorded step */
+	int32 PendingHotbarSlot = 0;
+	float PendingHotbarScroll = 0.0f;
+
+	/** Last values written, so unchanged aim isn't stored every step */
+	FInputReplayFrame LastRecorded;
+
+	/** Next frame to apply during playback */
+	int32 PlaybackIndex = 0;
+
+	int32 ZombiesKilled = 0;
+
+	FDelegateHandle StepHandle;
+	FDelegateHandle TickStartHandle;
+	FDelegateHandle WaveStartedHandle;
+	FDelegateHandle ZombieDiedHandle;
+};
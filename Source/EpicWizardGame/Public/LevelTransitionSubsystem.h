@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "LevelTransitionSubsystem.generated.h"
+
+/**
+ * Loads gameplay maps in the background so travel doesn't block on a cold OpenLevel.
+ * The map package (and everything its actors hard reference) is loaded with LoadPackageAsync
+ * and kept resident until the travel finishes, so LoadMap finds it already in memory. Zombie
+ * classes, their animations and projectile classes are soft references the wave manager loads
+ * before round 1, not part of this. The title screen preloads the default
+ * gameplay map on its own; TravelToLevel (or TravelToGameplayLevel from the title screen's Play
+ * button) switches over as soon as the load is done.
+ * Time from the travel request to the first frame of the new map is logged and kept. Travel that
+ * bypasses us (a Blueprint calling Open Level) is timed from the start of the map load instead.
+ */
+UCLASS(Config=Game)
+class EPICWIZARDGAME_API ULevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Get the subsystem from any world context object */
+	static ULevelTransitionSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Start loading a map in the background; short names resolve against LevelsPath */
+	UFUNCTION(BlueprintCallable, Category="Level Transition")
+	void PreloadLevel(const FString& LevelName);
+
+	/** Travel to a map, waiting for its background load first if needed */
+	UFUNCTION(BlueprintCallable, Category="Level Transition")
+	void TravelToLevel(const FString& LevelName);
+
+	/** Travel to the map the title screen preloads; what the title screen's Play button should call */
+	UFUNCTION(BlueprintCallable, Category="Level Transition")
+	void TravelToGameplayLevel();
+
+	/** Has the map finished loading in the background */
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	bool IsLevelPreloaded(const FString& LevelName) const;
+
+	/** Milliseconds from the last travel request to the first frame of the new map (0 before any travel) */
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	float GetLastTimeToInteractiveMs() const { return LastTimeToInteractiveMs; }
+
+protected:
+
+	/** Folder short map names are looked up in */
+	UPROPERTY(Config)
+	FString LevelsPath = TEXT("/Game/WizardsLastStand/Levels");
+
+	/** Map the title screen starts loading as soon as it is shown (empty to disable) */
+	UPROPERTY(Config)
+	FString TitleScreenPreloadLevel = TEXT("Courtyard");
+
+	/** Map package currently loading or loaded */
+	FString PreloadPackageName;
+
+	/** Keeps the loaded map package alive until we travel into it */
+	UPROPERTY(Transient)
+	TObjectPtr<UPackage> PreloadedPackage;
+
+	/** An async load of PreloadPackageName is in flight */
+	bool bPreloadInFlight = false;
+
+	/** Travel into PreloadPackageName as soon as its load completes */
+	bool bTravelWhenLoaded = false;
+
+	/** FPlatformTime::Seconds() at the travel request, 0 when no travel is being timed */
+	double TravelRequestTime = 0.0;
+
+	/** FPlatformTime::Seconds() when the preload was issued */
+	double PreloadStartTime = 0.0;
+
+	/** Result of the last timed travel */
+	float LastTimeToInteractiveMs = 0.0f;
+
+	FDelegateHandle PreLoadMapHandle;
+
+	FDelegateHandle PostLoadMapHandle;
+
+	FDelegateHandle EndFrameHandle;
+
+	/** Turn a short map name into a long package name */
+	FString ResolveLevelPackage(const FString& LevelName) const;
+
+	/** Async load callback for the map package */
+	void OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/** Open the preloaded map */
+	void OpenPreloadedLevel();
+
+	/** Start timing travel that didn't come through TravelToLevel */
+	void OnPreLoadMap(const FString& MapName);
+
+	/** Kick off the title screen preload, and start timing the first frame after a travel */
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	/** First frame of the new map has been presented */
+	void OnFirstFrameAfterTravel();
+};
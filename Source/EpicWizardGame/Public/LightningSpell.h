@@ -32,7 +32,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float AOEDamageMultiplier = 0.5f;
 
-	/** Projectile class to spawn for lightning visual */
+	/** Projectile class whose mesh is used for the lightning visual */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	TSubclassOf<ASpellProjectile> ProjectileClass;
 
@@ -40,13 +40,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float SpawnDistance = 100.0f;
 
-	/** How high above the strike point to spawn the lightning visual */
+	/** How high above the strike point the lightning visual starts */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float LightningStrikeHeight = 600.0f;
 
-	/** Speed multiplier for the downward strike visual */
+	/** Speed of the downward strike visual */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	float LightningStrikeSpeed = 3000.0f;
 
-	virtual void Execute(AWizardCharacter* Caster) override;
+	virtual bool Execute(AWizardCharacter* Caster) override;
 };
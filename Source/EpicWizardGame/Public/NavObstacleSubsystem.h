@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavObstacleSubsystem.generated.h"
+
+class UNavModifierComponent;
+
+/**
+ * Feeds turret nav modifiers into the navmesh a few at a time.
+ * Each registered modifier dirties the tiles under it, so spreading registrations over frames
+ * spreads the tile rebuilds too. OnNavMeshRebuilt fires on the event bus once the queue is
+ * empty and the navmesh has picked up and finished building the dirty tiles.
+ * Obstacles removed during a wave keep their nav hole until the next build break, so the
+ * navmesh is never rebuilt while zombies are pathing on it.
+ * This relies on the level's navmesh generating at runtime from modifiers only; a navmesh
+ * overriding that is reported when the world begins play.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UNavObstacleSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Modifiers registered with the navigation system per frame */
+	static constexpr int32 MaxObstaclesPerFrame = 2;
+
+	/** Queue an unregistered nav modifier to be registered */
+	void QueueObstacle(UNavModifierComponent* Modifier);
+
+	/** Destroy an obstacle's owner now, or hide it and hold it until the next build break while a wave is running */
+	void RemoveObstacle(AActor* ObstacleOwner);
+
+	/** True while queued modifiers or dirty tiles are still waiting to be built */
+	bool IsRebuildPending() const;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Modifiers waiting to be registered */
+	TArray<TWeakObjectPtr<UNavModifierComponent>> PendingObstacles;
+
+	/** Frames to let the navigation system pick up new modifiers before asking whether it is still building */
+	static constexpr uint64 NavSettleFrames = 2;
+
+	void OnWaveStarted(int32 Wave);
+
+	void OnWaveCompleted(int32 Wave);
+
+	/** Destroy the owners held back during the wave */
+	void FlushDeferredRemovals();
+
+	/** Obstacle owners removed mid-wave, destroyed at the next build break */
+	TArray<TWeakObjectPtr<AActor>> DeferredRemovals;
+
+	/** Set once the nav obstacles changed, cleared when the navmesh reports it has finished */
+	bool bAwaitingNavBuild = false;
+
+	/** Frame of the last change; the navmesh is only asked once it has had a chance to queue the dirty tiles */
+	uint64 LastChangeFrame = 0;
+
+	bool bWaveRunning = false;
+
+	FDelegateHandle WaveStartedHandle;
+	FDelegateHandle WaveCompletedHandle;
+	FDelegateHandle RunRestartedHandle;
+};
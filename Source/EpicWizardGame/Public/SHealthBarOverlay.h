@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class UHealthBarSubsystem;
+class APlayerController;
+
+/**
+ * Full-screen HUD layer that draws every registered health bar in a single paint pass.
+ * Bars over full-HP or off-screen actors are skipped.
+ */
+class EPICWIZARDGAME_API SHealthBarOverlay : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SHealthBarOverlay)
+		: _BackgroundColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.6f))
+		, _HealthyColor(FLinearColor(0.1f, 0.8f, 0.1f))
+		, _CriticalColor(FLinearColor(0.85f, 0.1f, 0.05f))
+		{}
+
+		/** Colour behind the fill */
+		SLATE_ARGUMENT(FLinearColor, BackgroundColor)
+
+		/** Fill colour at full HP */
+		SLATE_ARGUMENT(FLinearColor, HealthyColor)
+
+		/** Fill colour near zero HP */
+		SLATE_ARGUMENT(FLinearColor, CriticalColor)
+
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UHealthBarSubsystem* InRegistry, APlayerController* InPlayerController);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+
+	TWeakObjectPtr<UHealthBarSubsystem> Registry;
+
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	FLinearColor BackgroundColor;
+
+	FLinearColor HealthyColor;
+
+	FLinearColor CriticalColor;
+
+	/** Brush shared by every bar */
+	const FSlateBrush* WhiteBrush = nullptr;
+};
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimulationStepSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSimulationStep, float /*StepSeconds*/);
+
+/** Who a step callback belongs to; groups run in this order every step, after the gameplay timers */
+UENUM()
+enum class ESimulationStepGroup : uint8
+{
+	Turrets,
+	AreaEffects,
+	Other,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Fixed-rate gameplay simulation step, independent of the render frame rate.
+ * Frame time is accumulated and spent in whole steps (30 Hz by default, -SimRate=<Hz> to override),
+ * so turret fire rates, area effect movement and the gameplay timers (zombie AI, status effects) give
+ * the same results at 20 fps as at 144. When a frame would need more than MaxStepsPerFrame steps the
+ * rate is lowered for a while instead of letting the game fall behind real time, unless the rate is
+ * locked (recording a replay), in which case the game slows down instead.
+ */
+UCLASS()
+class EPICWIZARDGAME_API USimulationStepSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Steps run in a single frame before the rate is lowered */
+	static constexpr int32 MaxStepsPerFrame = 4;
+
+	/** Lowest rate we drop to under load */
+	static constexpr float MinStepRate = 10.0f;
+
+	/** Highest rate that can be requested */
+	static constexpr float MaxStepRate = 120.0f;
+
+	/** Called every step for a group; AddUObject in BeginPlay and Remove in EndPlay */
+	FOnSimulationStep& OnStep(ESimulationStepGroup Group) { return StepDelegates[static_cast<uint8>(Group)]; }
+
+	/** Run Callback every step for Duration seconds, or until Owner is destroyed */
+	void RunForDuration(ESimulationStepGroup Group, const UObject* Owner, float Duration, TFunction<void(float)> Callback);
+
+	/** Set the target step rate (Hz), clamped to [MinStepRate, MaxStepRate] */
+	void SetStepRate(float NewStepRate);
+
+	/** Hold the rate at the target under load, so every step covers the same simulated time */
+	void SetStepRateLocked(bool bLocked);
+
+	bool IsStepRateLocked() const { return bStepRateLocked; }
+
+	/** Rate the game asked for */
+	float GetTargetStepRate() const { return TargetStepRate; }
+
+	/** Rate currently being stepped at; below the target while under load */
+	float GetStepRate() const { return StepRate; }
+
+	/** Length of one step (seconds) */
+	float GetStepSeconds() const { return 1.0f / StepRate; }
+
+	/** Simulated seconds since the world started */
+	double GetSimulationTime() const { return SimulationTime; }
+
+	/** Steps run since the world started; the current step's number while one is running */
+	uint32 GetStepCount() const { return StepCount; }
+
+	/** Run exactly one step, outside the frame accumulator */
+	void Step();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Callback registered through RunForDuration */
+	struct FTimedStep
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		float RemainingTime = 0.0f;
+		TFunction<void(float)> Callback;
+	};
+
+	FOnSimulationStep StepDelegates[static_cast<uint8>(ESimulationStepGroup::Count)];
+
+	TArray<FTimedStep> TimedSteps[static_cast<uint8>(ESimulationStepGroup::Count)];
+
+	float TargetStepRate = 30.0f;
+
+	float StepRate = 30.0f;
+
+	/** Frame time not yet spent on steps */
+	double Accumulator = 0.0;
+
+	double SimulationTime = 0.0;
+
+	uint32 StepCount = 0;
+
+	/** Seconds without an overloaded frame while running below the target rate */
+	float TimeSinceOverload = 0.0f;
+
+	/** Never lower the rate under load */
+	bool bStepRateLocked = false;
+};
@@ -29,17 +29,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spell")
 	FString SpellName = "Spell";
 
-	/** Execute the spell - override in child classes */
+	/** Execute the spell - override in child classes. Returns false if nothing was cast (no target, no aim), so no cooldown is used */
 	UFUNCTION(BlueprintCallable, Category="Spell")
-	virtual void Execute(AWizardCharacter* Caster);
-
-	/** Can this spell be cast right now? */
-	UFUNCTION(BlueprintPure, Category="Spell")
-	bool CanCast() const;
-
-	/** Get time remaining on cooldown */
-	UFUNCTION(BlueprintPure, Category="Spell")
-	float GetCooldownRemaining() const;
+	virtual bool Execute(AWizardCharacter* Caster);
 
 protected:
 
@@ -48,10 +40,4 @@ protected:
 	/** Reference to the wizard who owns this spell */
 	UPROPERTY()
 	AWizardCharacter* OwnerWizard;
-
-	/** Time when this spell was last cast */
-	float LastCastTime = -999.0f;
-
-	/** Start cooldown timer */
-	void StartCooldown();
 };
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SpellbookComponent.generated.h"
+
+class ASpellBase;
+
+UENUM(BlueprintType)
+enum class ESpellCastResult : uint8
+{
+	Cast UMETA(DisplayName = "Cast"),
+	OnCooldown UMETA(DisplayName = "On Cooldown"),
+	NoSpell UMETA(DisplayName = "No Spell"),
+	/** The spell had nothing to cast at (no aim, lightning missed); no cooldown was used */
+	Failed UMETA(DisplayName = "Failed")
+};
+
+/**
+ * The wizard's spells, one instance per hotbar slot.
+ * Spell instances are created the first time a slot is cast and reused afterwards, and cooldowns
+ * are kept as end timestamps in a flat array indexed by slot, so a cast is an indexed lookup.
+ * This array is the only cooldown state; a slot only goes on cooldown when its spell reports a cast.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class EPICWIZARDGAME_API USpellbookComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	USpellbookComponent();
+
+	/** Cast the spell in a slot, creating its instance first if the slot holds a different class */
+	ESpellCastResult CastSlot(int32 SlotIndex, TSubclassOf<ASpellBase> SpellClass);
+
+	/** Seconds until the slot can be cast again */
+	UFUNCTION(BlueprintPure, Category="Spellbook")
+	float GetCooldownRemaining(int32 SlotIndex) const;
+
+	/** True if the slot is off cooldown */
+	UFUNCTION(BlueprintPure, Category="Spellbook")
+	bool IsSlotReady(int32 SlotIndex) const { return GetCooldownRemaining(SlotIndex) <= 0.0f; }
+
+	/** Put every slot off cooldown */
+	void ResetCooldowns();
+
+	/** Spell instance in a slot, nullptr until the slot is first cast */
+	UFUNCTION(BlueprintPure, Category="Spellbook")
+	ASpellBase* GetSpellInSlot(int32 SlotIndex) const;
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Make sure the slot holds an instance of SpellClass */
+	ASpellBase* EnsureSlotSpell(int32 SlotIndex, TSubclassOf<ASpellBase> SpellClass);
+
+	/** Spell instance per slot */
+	UPROPERTY(Transient)
+	TArray<ASpellBase*> SlotSpells;
+
+	/** World time each slot comes off cooldown */
+	TArray<double> CooldownEndTimes;
+};
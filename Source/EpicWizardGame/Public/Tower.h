@@ -6,8 +6,9 @@
 #include "GameFramework/Actor.h"
 #include "Tower.generated.h"
 
-class UWidgetComponent;
 class UBoxComponent;
+class UWidgetComponent;
+class UAttackSlotComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FTowerDestroyedDelegate);
 
@@ -18,14 +19,14 @@ class EPICWIZARDGAME_API ATower : public AActor
 
 protected:
 
-	/** Floating health bar widget */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
-	UWidgetComponent* HealthBarWidget;
-
 	/** Collision box for zombie attacks */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UBoxComponent* AttackCollision;
 
+	/** Attack positions handed out to zombies around the attack box */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UAttackSlotComponent* AttackSlots;
+
 	/** Max HP for the tower */
 	UPROPERTY(EditAnywhere, Category="Health")
 	float MaxHP = 1000.0f;
@@ -37,6 +38,21 @@ protected:
 	/** True if tower is destroyed */
 	bool bIsDestroyed = false;
 
+	/** Deprecated: floating health bars are drawn by UHealthBarSubsystem now. Always null; kept for one release so Blueprints reading it still compile */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(DeprecatedProperty, DeprecationMessage="Health bars are drawn by the health bar subsystem; this is always None"))
+	UWidgetComponent* HealthBarWidget = nullptr;
+
+	/** Height of the floating health bar above the actor origin */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	float HealthBarHeight = 300.0f;
+
+	/** Size of the floating health bar on screen */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	FVector2D HealthBarSize = FVector2D(160.0f, 14.0f);
+
+	/** Handle of our bar in the health bar registry */
+	int32 HealthBarHandle = INDEX_NONE;
+
 public:
 
 	/** Delegate broadcast when tower is destroyed */
@@ -50,6 +66,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -77,11 +95,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Tower")
 	float GetMaxHP() const { return MaxHP; }
 
+	/** Returns the attack slot allocator */
+	UAttackSlotComponent* GetAttackSlots() const { return AttackSlots; }
+
+	/** Restore full HP for a restarted run */
+	void ResetTower();
+
+	/** Set HP directly (clamped to max), used when restoring a wave snapshot */
+	void SetCurrentHP(float NewHP);
+
 protected:
 
 	/** Called when tower HP is depleted */
 	void DestroyTower();
 
+	/** Push our HP ratio to the health bar registry */
+	void UpdateHealthBar();
+
+	/** Tell zombies entering the attack box that they are in range */
+	UFUNCTION()
+	void OnAttackCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Tell zombies leaving the attack box that they are out of range */
+	UFUNCTION()
+	void OnAttackCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
 	/** Blueprint event for taking damage */
 	UFUNCTION(BlueprintImplementableEvent, Category="Tower", meta=(DisplayName="On Tower Damaged"))
 	void BP_OnTowerDamaged(float DamageTaken, float RemainingHP);
@@ -89,4 +129,8 @@ protected:
 	/** Blueprint event for tower destruction */
 	UFUNCTION(BlueprintImplementableEvent, Category="Tower", meta=(DisplayName="On Tower Destroyed"))
 	void BP_OnTowerDestroyed();
+
+	/** Blueprint event when a run restart or wave rollback restores the tower in place; undo whatever On Tower Destroyed changed */
+	UFUNCTION(BlueprintImplementableEvent, Category="Tower", meta=(DisplayName="On Run Restarted"))
+	void BP_OnRunRestarted();
 };
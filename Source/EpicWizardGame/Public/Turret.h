@@ -11,7 +11,8 @@ class ASpellProjectile;
 class USceneComponent;
 class UBoxComponent;
 class UWidgetComponent;
-class UUserWidget;
+class UAttackSlotComponent;
+class UNavModifierComponent;
 
 UCLASS()
 class EPICWIZARDGAME_API ATurret : public APawn
@@ -24,17 +25,21 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	USceneComponent* SceneRoot;
 
-	/** Floating health bar widget */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
-	UWidgetComponent* HealthBarWidget;
-
 	/** Collision box for zombie attacks (query-only overlap) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UBoxComponent* AttackCollision;
 
-	/** Projectile class to spawn (use BP_Projectile - the fireball) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
-	TSubclassOf<ASpellProjectile> ProjectileClass;
+	/** Attack positions handed out to zombies around the attack box */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UAttackSlotComponent* AttackSlots;
+
+	/** Cuts the turret's footprint out of the navmesh. Registered through the nav obstacle subsystem so tile rebuilds are spread over frames */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UNavModifierComponent* NavModifier;
+
+	/** Projectile class to spawn (use BP_Projectile - the fireball); soft so it loads with the wave preload. Blueprints use Get/SetProjectileClass */
+	UPROPERTY(EditAnywhere, Category="Combat")
+	TSoftClassPtr<ASpellProjectile> ProjectileClass;
 
 	/** Detection range for finding zombies */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
@@ -60,9 +65,12 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
 	float ProjectileVisualPitchOffset = 0.0f;
 
-	/** Timer for firing */
+	/** Seconds until the next shot, counted down on the simulation step */
 	float FireTimer = 0.0f;
 
+	/** Our registration with the simulation step */
+	FDelegateHandle SimulationStepHandle;
+
 	/** Max HP for the turret */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Health")
 	float MaxHP = 100.0f;
@@ -79,6 +87,21 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category="Turret")
 	bool bIsPreviewTurret = false;
 
+	/** Deprecated: floating health bars are drawn by UHealthBarSubsystem now. Always null; kept for one release so Blueprints reading it still compile */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(DeprecatedProperty, DeprecationMessage="Health bars are drawn by the health bar subsystem; this is always None"))
+	UWidgetComponent* HealthBarWidget = nullptr;
+
+	/** Height of the floating health bar above the actor origin */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	float HealthBarHeight = 120.0f;
+
+	/** Size of the floating health bar on screen */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	FVector2D HealthBarSize = FVector2D(100.0f, 10.0f);
+
+	/** Handle of our bar in the health bar registry */
+	int32 HealthBarHandle = INDEX_NONE;
+
 public:
 	// Sets default values for this pawn's properties
 	ATurret();
@@ -87,10 +110,12 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Targeting and firing, run at the fixed simulation rate so DPS doesn't depend on frame rate */
+	void SimulationStep(float StepSeconds);
 
+public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -109,6 +134,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Turret|Health")
 	float GetMaxHP() const { return MaxHP; }
 
+	/** Set HP directly (clamped to max), used when restoring a wave snapshot */
+	void SetCurrentHP(float NewHP);
+
+	/** Add the assets this turret needs once it starts firing, called on the CDO to preload them before a wave */
+	virtual void GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const;
+
+	/** ProjectileClass, loaded on the spot if the wave preload didn't already bring it in */
+	UFUNCTION(BlueprintPure, Category="Combat")
+	TSubclassOf<ASpellProjectile> GetProjectileClass() const;
+
+	/** Change the projectile class */
+	UFUNCTION(BlueprintCallable, Category="Combat")
+	void SetProjectileClass(TSubclassOf<ASpellProjectile> NewProjectileClass);
+
 	/** Returns true if turret is destroyed */
 	UFUNCTION(BlueprintCallable, Category="Turret")
 	bool IsDestroyed() const { return bIsDestroyed; }
@@ -117,6 +156,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Turret")
 	bool IsPreviewTurret() const { return bIsPreviewTurret; }
 
+	/** Returns the attack slot allocator */
+	UAttackSlotComponent* GetAttackSlots() const { return AttackSlots; }
+
 	/** Mark turret as a placement preview (hides health bar, makes it untargetable) */
 	UFUNCTION(BlueprintCallable, Category="Turret")
 	void SetIsPreviewTurret(bool bIsPreview);
@@ -132,6 +174,22 @@ protected:
 	/** Called when turret HP is depleted */
 	void DestroyTurret();
 
+	/** Add or remove our floating health bar (previews don't get one) */
+	void RefreshHealthBarRegistration();
+
+	/** Push our HP ratio to the health bar registry */
+	void UpdateHealthBar();
+
+	/** Tell zombies entering the attack box that they are in range */
+	UFUNCTION()
+	void OnAttackCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Tell zombies leaving the attack box that they are out of range */
+	UFUNCTION()
+	void OnAttackCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
 	/** Blueprint event for taking damage */
 	UFUNCTION(BlueprintImplementableEvent, Category="Turret", meta=(DisplayName="On Turret Damaged"))
 	void BP_OnTurretDamaged(float DamageTaken, float RemainingHP);
@@ -17,9 +17,9 @@ public:
 
 protected:
 
-	/** Projectile class to spawn for the airblast */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(DisplayName="Projectile Class"))
-	TSubclassOf<AActor> AirProjectileClass;
+	/** Actor to spawn for the airblast; left as plain AActor, the pooled cosmetic visual is used instead */
+	UPROPERTY(EditAnywhere, Category="Combat", meta=(DisplayName="Projectile Class"))
+	TSoftClassPtr<AActor> AirProjectileClass;
 
 	/** AOE radius around the airblast projectile */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
@@ -38,4 +38,16 @@ protected:
 	float ProjectileLifetime = 1.0f;
 
 	virtual void ShootAtTarget(AZombieCharacter* Target) override;
+
+public:
+
+	virtual void GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const override;
+
+	/** AirProjectileClass, loaded on the spot if the wave preload didn't already bring it in */
+	UFUNCTION(BlueprintPure, Category="Combat")
+	TSubclassOf<AActor> GetAirProjectileClass() const;
+
+	/** Change the airblast actor class */
+	UFUNCTION(BlueprintCallable, Category="Combat")
+	void SetAirProjectileClass(TSubclassOf<AActor> NewProjectileClass);
 };
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TurretGhost.generated.h"
+
+class ATurret;
+class UStaticMeshComponent;
+class UMaterialInterface;
+
+/** Mesh components that draw one turret class */
+USTRUCT()
+struct FTurretGhostMeshSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UStaticMeshComponent*> Meshes;
+};
+
+/**
+ * Translucent placement preview for turrets.
+ * Only copies the static meshes of each turret class, with no collision, tick, health or AI.
+ * Mesh sets are built the first time a class is shown and kept, so switching turret type is a
+ * visibility toggle. Ghost materials are created once per source material and shared.
+ */
+UCLASS(NotPlaceable)
+class EPICWIZARDGAME_API ATurretGhost : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	ATurretGhost();
+
+	/** Material overrides used for every mesh. If null, the source materials get an Opacity parameter instead */
+	void SetGhostMaterial(UMaterialInterface* InGhostMaterial, float InOpacity);
+
+	/** Show the meshes for a turret class, building them on first use */
+	void ShowTurretClass(TSubclassOf<ATurret> TurretClass);
+
+	/** Turret class currently shown */
+	TSubclassOf<ATurret> GetTurretClass() const { return CurrentClass; }
+
+	/** Show or hide the ghost without changing its class */
+	void SetGhostVisible(bool bVisible);
+
+private:
+
+	/** Create mesh components matching every static mesh on the turret class */
+	void BuildMeshSet(TSubclassOf<ATurret> TurretClass, FTurretGhostMeshSet& OutSet);
+
+	/** Shared ghost version of a source material */
+	UMaterialInterface* GetGhostMaterial(UMaterialInterface* SourceMaterial);
+
+	UPROPERTY()
+	USceneComponent* SceneRoot;
+
+	/** Preview material override */
+	UPROPERTY()
+	UMaterialInterface* GhostMaterial;
+
+	float GhostOpacity = 0.5f;
+
+	/** Pooled meshes per turret class */
+	UPROPERTY()
+	TMap<TSubclassOf<ATurret>, FTurretGhostMeshSet> MeshSets;
+
+	/** Ghost material for each source material, shared by every mesh set */
+	UPROPERTY()
+	TMap<UMaterialInterface*, UMaterialInterface*> MaterialCache;
+
+	TSubclassOf<ATurret> CurrentClass;
+};
@@ -29,7 +29,7 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
 	float LightningStrikeHeight = 600.0f;
 
-	/** Speed multiplier for the downward strike visual */
+	/** Speed of the downward strike visual */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat")
 	float LightningStrikeSpeed = 3000.0f;
 
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TurretPlacementGrid.generated.h"
+
+class UBoxComponent;
+class ATurret;
+
+UENUM(BlueprintType)
+enum class EPathBlockingPolicy : uint8
+{
+	Reject UMETA(DisplayName = "Reject"),
+	Warn UMETA(DisplayName = "Warn"),
+	Allow UMETA(DisplayName = "Allow")
+};
+
+/**
+ * Buildable turret grid for a level.
+ * Place one in the level and scale the bounds over the playable floor. On BeginPlay every cell is
+ * baked once against the floor geometry and the navmesh. After that, snapping and validation are
+ * O(1) bitmap lookups and nothing is traced per frame.
+ * The grid is axis aligned; actor rotation is ignored.
+ */
+UCLASS()
+class EPICWIZARDGAME_API ATurretPlacementGrid : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	ATurretPlacementGrid();
+
+	/** Returns the first placement grid in the world, or nullptr if the level has none */
+	static ATurretPlacementGrid* Find(const UObject* WorldContextObject);
+
+	/** Convert a world location to the cell that contains it. Returns false outside the grid */
+	bool WorldToCell(const FVector& WorldLocation, FIntPoint& OutCell) const;
+
+	/** Intersect a ray with the grid plane and return the cell it lands in */
+	bool RayToCell(const FVector& RayOrigin, const FVector& RayDirection, FIntPoint& OutCell) const;
+
+	/** World location of a cell's centre, on the baked floor height */
+	FVector GetCellLocation(const FIntPoint& Cell) const;
+
+	/** True if the cell has buildable floor and nothing is standing on it */
+	bool IsCellPlaceable(const FIntPoint& Cell) const;
+
+	/** True if a turret on this cell would cut a spawn gate off from the tower */
+	bool WouldBlockZombiePath(const FIntPoint& Cell);
+
+	/** What to do with placements that would block zombie paths */
+	EPathBlockingPolicy GetPathBlockingPolicy() const { return PathBlockingPolicy; }
+
+	/** Marks the cell under a turret occupied and frees it again when the turret is destroyed */
+	void OccupyCell(const FIntPoint& Cell, ATurret* Turret);
+
+	/** Edge length of one cell */
+	float GetCellSize() const { return CellSize; }
+
+protected:
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Area covered by the grid */
+	UPROPERTY(VisibleAnywhere, Category="Components")
+	UBoxComponent* GridBounds;
+
+	/** Edge length of one cell, roughly one turret footprint */
+	UPROPERTY(EditAnywhere, Category="Grid", meta=(ClampMin="50.0"))
+	float CellSize = 250.0f;
+
+	/** Steepest floor (normal Z) a turret can stand on */
+	UPROPERTY(EditAnywhere, Category="Grid", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float MinFloorNormalZ = 0.85f;
+
+	/** How far the navmesh may sit from the traced floor and still count as the same surface */
+	UPROPERTY(EditAnywhere, Category="Grid", meta=(ClampMin="0.0"))
+	float NavHeightTolerance = 50.0f;
+
+	/** Whether placements that seal off a spawn gate are refused, logged, or allowed */
+	UPROPERTY(EditAnywhere, Category="Grid")
+	EPathBlockingPolicy PathBlockingPolicy = EPathBlockingPolicy::Reject;
+
+	/** Draw the baked cells for a few seconds after BeginPlay */
+	UPROPERTY(EditAnywhere, Category="Grid|Debug")
+	bool bDrawDebugCells = false;
+
+private:
+
+	/** Trace every cell against the floor and the navmesh */
+	void BakeCells();
+
+	/** Mark the cells under every tower occupied */
+	void OccupyTowerFootprints();
+
+	/** Mark every cell overlapping a world-space box as occupied tower footprint */
+	void OccupyTowerBox(const FBox& Box);
+
+	/** Find the free walkable cell each spawn gate feeds into */
+	void FindGateCells();
+
+	/** Recompute which free cells are chokepoints between the gates and the tower */
+	void RebuildPathCuts();
+
+	/** True if zombies can walk through the cell right now */
+	bool IsCellFreeWalkable(int32 Index) const { return WalkableCells[Index] && !OccupiedCells[Index]; }
+
+	/** Flat index of a cell, INDEX_NONE outside the grid */
+	int32 CellToIndex(const FIntPoint& Cell) const;
+
+	void OnTurretPlaced(ATurret* Turret, int32 Cost);
+
+	UFUNCTION()
+	void OnTurretDestroyed(AActor* DestroyedActor);
+
+	/** Minimum corner of the grid */
+	FVector GridOrigin = FVector::ZeroVector;
+
+	/** Height of the plane used for cursor rays, the average baked floor height */
+	float PlaneZ = 0.0f;
+
+	int32 NumCellsX = 0;
+	int32 NumCellsY = 0;
+
+	/** Baked floor height per cell */
+	TArray<float> CellHeights;
+
+	/** One bit per cell, set if the cell has buildable floor */
+	TBitArray<> BuildableCells;
+
+	/** One bit per cell, set if a turret or the tower stands on it */
+	TBitArray<> OccupiedCells;
+
+	/** One bit per cell, set if the cell is on the navmesh */
+	TBitArray<> WalkableCells;
+
+	/** One bit per cell, set if the tower footprint covers it */
+	TBitArray<> TowerCells;
+
+	/** One bit per cell, set if occupying it would disconnect a spawn gate from the tower */
+	TBitArray<> PathCutCells;
+
+	/** Cells the spawn gates feed into */
+	TArray<int32> GateCells;
+
+	/** Set whenever occupancy changes; the cut cells are recomputed on the next query */
+	bool bPathCutsDirty = true;
+
+	/** Cell index held by each live turret */
+	TMap<TObjectKey<AActor>, int32> TurretCells;
+
+	FDelegateHandle TurretPlacedHandle;
+};
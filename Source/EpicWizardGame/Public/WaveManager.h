@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WaveSnapshot.h"
 #include "WaveManager.generated.h"
 
 class AZombieSpawnManager;
 class UBuildModeTimerWidget;
+class AZombieCharacter;
+struct FStreamableHandle;
 
 UCLASS()
 class EPICWIZARDGAME_API AWaveManager : public AActor
@@ -44,6 +47,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Wave System")
 	float TimeBetweenWaves = 15.0f;
 
+	/** How often to re-check when a wave is held back by a pending navmesh rebuild (seconds) */
+	UPROPERTY(EditAnywhere, Category="Wave System", meta=(ClampMin="0.01"))
+	float NavRebuildWaitInterval = 0.1f;
+
 	/** Base zombie health for round 1 */
 	UPROPERTY(EditAnywhere, Category="Wave System|Health")
 	float BaseZombieHealth = 150.0f;
@@ -72,10 +79,26 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Wave System")
 	bool bAutoStartFirstWave = true;
 
+	/** Write every wave start snapshot to Saved/WaveSnapshots (also enabled by -SaveWaveSnapshots) */
+	UPROPERTY(EditAnywhere, Category="Wave System|Snapshots")
+	bool bSaveWaveSnapshots = false;
+
 	/** Reference to spawn manager */
 	UPROPERTY()
 	AZombieSpawnManager* SpawnManager;
 
+	/** State captured at the start of the current wave */
+	FWaveSnapshot WaveStartSnapshot;
+
+	/** Has WaveStartSnapshot been captured or loaded */
+	bool bHasWaveStartSnapshot = false;
+
+	/** Keeps the assets for the coming wave loaded; requested before the wave, released when the next preload replaces it */
+	TSharedPtr<FStreamableHandle> WaveAssetsHandle;
+
+	/** Spawn seed the next StartNextWave must use instead of a fresh one (set when restoring a snapshot) */
+	TOptional<int32> PendingWaveSeed;
+
 	/** Total zombies to spawn this wave */
 	int32 TotalZombiesThisWave = 0;
 
@@ -94,6 +117,18 @@ protected:
 	/** Time when build mode started */
 	float BuildModeStartTime = 0.0f;
 
+	/** Fires on each whole second of the build mode countdown */
+	FTimerHandle BuildModeCountdownTimer;
+
+	/** Our subscription to zombie deaths on the event bus */
+	FDelegateHandle ZombieDiedHandle;
+
+	/** Our subscription to run loss on the event bus */
+	FDelegateHandle RunLostHandle;
+
+	/** Set when the run is lost, cleared by RestartRun */
+	bool bRunLost = false;
+
 public:
 
 	// Sets default values for this actor's properties
@@ -104,10 +139,9 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+public:
 
 	/** Start the next wave */
 	UFUNCTION(BlueprintCallable, Category="Wave System")
@@ -165,9 +199,36 @@ public:
 	UFUNCTION(BlueprintPure, Category="Economy")
 	int32 GetPlayerMoney() const { return PlayerMoney; }
 
-	/** Called when a zombie dies */
-	UFUNCTION()
-	void OnZombieDied();
+	/** Called when a zombie dies (via the gameplay event bus) */
+	void OnZombieDied(AZombieCharacter* Zombie);
+
+	/** Reset the running world for a fresh run: zombies, turrets, tower, wizard, money and waves */
+	UFUNCTION(BlueprintCallable, Category="Wave System")
+	void RestartRun();
+
+	/** Has the current run been lost */
+	UFUNCTION(BlueprintPure, Category="Wave System")
+	bool IsRunLost() const { return bRunLost; }
+
+	/** Restore the state captured at the start of the current wave and replay it, returns false without a snapshot */
+	UFUNCTION(BlueprintCallable, Category="Wave System")
+	bool RollbackToWaveStart();
+
+	/** Is there a wave start to roll back to */
+	UFUNCTION(BlueprintPure, Category="Wave System")
+	bool HasWaveStartSnapshot() const { return bHasWaveStartSnapshot; }
+
+	/** State captured at the start of the current wave */
+	const FWaveSnapshot& GetWaveStartSnapshot() const { return WaveStartSnapshot; }
+
+	/** Replace the running world with a snapshot and start its wave */
+	void ApplyWaveSnapshot(const FWaveSnapshot& Snapshot);
+
+	/** Read a snapshot file and apply it, returns false if the file is missing or invalid */
+	bool LoadWaveSnapshotFromFile(const FString& FilePath);
+
+	/** Folder wave snapshots are saved to and relative snapshot paths resolve against */
+	static FString GetWaveSnapshotDir();
 
 protected:
 
@@ -182,4 +243,22 @@ protected:
 
 	/** Start wave break timer */
 	void StartWaveBreak();
+
+	/** Async load what the next wave will spawn and what the player can afford to build */
+	void PreloadNextWaveAssets();
+
+	/** Start a wave without a break before it (round 1, a restart, a restored snapshot), held until its assets have loaded */
+	void PreloadAndStartNextWave();
+
+	/** Broadcast the build mode countdown */
+	void BroadcastBuildModeSecond();
+
+	/** Freeze wave flow when the wizard dies or the tower falls */
+	void OnRunLost();
+
+	/** Stop the wave flow and remove zombies and turrets, shared by restart and rollback */
+	void ClearRunWorld();
+
+	/** Record wave number, money, tower, turrets and spawn seed for the wave about to start */
+	void CaptureWaveSnapshot(int32 Wave, int32 SpawnSeed);
 };
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WaveSimulationSubsystem.generated.h"
+
+class AWaveManager;
+class ATurret;
+class ATurretPlacementGrid;
+class AZombieCharacter;
+
+/** One row of the wave simulator's money curve */
+struct FWaveSimRound
+{
+	int32 Wave = 0;
+
+	/** Simulated seconds since the run started, when the wave started */
+	double StartTime = 0.0;
+
+	/** Simulated seconds from the wave starting to its last zombie dying, 0 if it never finished */
+	double Duration = 0.0;
+
+	int32 Zombies = 0;
+
+	float ZombieHealth = 0.0f;
+
+	int32 MoneyAtStart = 0;
+
+	/** Kill rewards over the wave, 0 if it never finished */
+	int32 MoneyEarned = 0;
+
+	/** Spent on turrets in the build break before this wave */
+	int32 MoneySpent = 0;
+
+	int32 TurretsAlive = 0;
+
+	float TowerHP = 0.0f;
+};
+
+/**
+ * Headless fast-forward wave balancing run.
+ * With -WaveSim the level plays itself: the wizard is removed, every build break spends the money on
+ * turrets from the hotbar placed around the tower (on the placement grid, or on rings projected onto
+ * the navmesh when the level has no grid), and the waves, spawn manager, turrets and zombies run
+ * with a fixed frame time of one simulation step and no frame limit. Run it on the game map with
+ * -game -nullrhi to go as fast as the CPU allows.
+ *
+ * Options: -WaveSimMaxWave=<n> (default 40), -WaveSimSlots=<hotbar slots to build from, e.g. 0,2>,
+ * -WaveSimWaveTimeout=<simulated seconds before a wave counts as stalled>, -WaveSimNoExit, plus
+ * -RandomSeed and -SimRate as usual.
+ *
+ * When the run is lost, stalls or reaches the last wave, it writes the money curve to
+ * Saved/WaveSim/<name>.csv and rounds survived, kills per turret type and throughput (simulated seconds
+ * per real second) to Saved/WaveSim/<name>.txt, then quits.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UWaveSimulationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	bool IsRunning() const { return bRunning; }
+
+	/** Where reports are written */
+	static FString GetReportDir();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+
+	/** A turret the build policy can buy */
+	struct FBuildOption
+	{
+		TSubclassOf<ATurret> TurretClass;
+		int32 Cost = 0;
+	};
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void StartSimulation();
+
+	/** Write the reports and quit */
+	void FinishSimulation(const TCHAR* Reason);
+
+	/** Put the engine's fixed time step back the way the run found it */
+	void RestoreFixedTimeStep();
+
+	/** Per step: remove the wizard once it's spawned and watch for stalled waves */
+	void SimulationStep(float StepSeconds);
+
+	/** Read the turret classes and costs off the hotbar, limited to -WaveSimSlots */
+	bool GatherBuildOptions();
+
+	/** Spend the money on turrets, cycling through the build options */
+	void BuildTurrets();
+
+	/** Free spot nearest the tower, from the grid if the level has one and from rings around the tower otherwise */
+	bool FindBuildLocation(FVector& OutLocation);
+
+	/** Free cell nearest the tower that doesn't cut off a spawn gate, false when the grid is full */
+	bool FindGridBuildLocation(ATurretPlacementGrid* Grid, const FVector& TowerLocation, FVector& OutLocation) const;
+
+	/** Navmesh point on the innermost ring around the tower with room between it and every turret, so zombies can walk through */
+	bool FindRingBuildLocation(const FVector& TowerLocation, FVector& OutLocation) const;
+
+	/** The level's placement grid, looked up once */
+	ATurretPlacementGrid* GetPlacementGrid();
+
+	/** Name a turret class is reported under */
+	static FString GetTurretTypeName(const UClass* TurretClass);
+
+	void OnWaveStarted(int32 Wave);
+
+	void OnWaveCompleted(int32 Wave);
+
+	void OnBuildModeSecondElapsed(int32 SecondsRemaining);
+
+	void OnZombieDied(AZombieCharacter* Zombie);
+
+	void OnRunLost();
+
+	AWaveManager* GetWaveManager() const;
+
+	bool WriteReports(const TCHAR* Reason) const;
+
+	bool bRunning = false;
+
+	mutable TWeakObjectPtr<AWaveManager> CachedWaveManager;
+
+	TWeakObjectPtr<ATurretPlacementGrid> CachedPlacementGrid;
+
+	/** The level was searched for a placement grid; it may not have one */
+	bool bLookedUpPlacementGrid = false;
+
+	/** Stop after this wave is cleared */
+	int32 MaxWave = 40;
+
+	/** Simulated seconds a wave may take before the run is called stalled */
+	float WaveTimeout = 600.0f;
+
+	bool bExitWhenDone = true;
+
+	/** The run switched the engine to a fixed time step; the previous setting is below */
+	bool bOverrodeFixedTimeStep = false;
+	bool bPrevUseFixedTimeStep = false;
+	double PrevFixedDeltaTime = 0.0;
+
+	/** Hotbar slots to build from; empty means every turret slot */
+	TArray<int32> AllowedSlots;
+
+	TArray<FBuildOption> BuildOptions;
+
+	/** Next build option to buy, so the money is spread across turret types */
+	int32 NextBuildOption = 0;
+
+	/** Already built in the current break */
+	bool bBuiltThisBreak = false;
+
+	/** Spent in the current break, moved onto the next wave's row */
+	int32 PendingMoneySpent = 0;
+
+	TArray<FWaveSimRound> Rounds;
+
+	/** Kills by turret type name; spells and anything else count as "Other" */
+	TMap<FString, int32> KillsByType;
+
+	TMap<FString, int32> TurretsBuiltByType;
+
+	int32 WavesCleared = 0;
+
+	double RealStartTime = 0.0;
+
+	FString ReportName;
+
+	FDelegateHandle StepHandle;
+	FDelegateHandle WaveStartedHandle;
+	FDelegateHandle WaveCompletedHandle;
+	FDelegateHandle BuildModeSecondHandle;
+	FDelegateHandle ZombieDiedHandle;
+	FDelegateHandle RunLostHandle;
+};
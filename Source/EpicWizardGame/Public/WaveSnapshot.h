@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One placed turret at the start of a wave */
+struct FTurretSnapshot
+{
+	/** Path of the turret class, e.g. /Game/.../BP_FireTurret.BP_FireTurret_C */
+	FString ClassPath;
+
+	FTransform Transform;
+
+	float CurrentHP = 0.0f;
+
+	friend FArchive& operator<<(FArchive& Ar, FTurretSnapshot& Turret)
+	{
+		return Ar << Turret.ClassPath << Turret.Transform << Turret.CurrentHP;
+	}
+};
+
+/**
+ * Compact binary state of a run at the start of a wave.
+ * Enough to roll back to that wave start in place, or to jump a fresh session straight to a late round.
+ */
+struct EPICWIZARDGAME_API FWaveSnapshot
+{
+	/** Bumped whenever the layout changes; older files are rejected */
+	static constexpr int32 CurrentVersion = 1;
+
+	/** Wave about to start */
+	int32 Wave = 0;
+
+	int32 PlayerMoney = 0;
+
+	float TowerHP = 0.0f;
+
+	/** Seed the spawn manager's random stream gets for this wave */
+	int32 SpawnSeed = 0;
+
+	TArray<FTurretSnapshot> Turrets;
+
+	/** Serialize to a byte buffer */
+	void SaveToBytes(TArray<uint8>& OutBytes);
+
+	/** Read from a byte buffer, returns false on a bad magic, version or truncated data */
+	bool LoadFromBytes(const TArray<uint8>& Bytes);
+
+	/** Write to a file */
+	bool SaveToFile(const FString& FilePath);
+
+	/** Read from a file */
+	bool LoadFromFile(const FString& FilePath);
+
+private:
+
+	void Serialize(FArchive& Ar);
+};
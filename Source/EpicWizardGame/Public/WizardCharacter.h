@@ -15,6 +15,8 @@ class UAnimInstance;
 class USkeletalMeshComponent;
 class UStaticMesh;
 class USpringArmComponent;
+class USpellbookComponent;
+enum class ESpellCastResult : uint8;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FWizardHealthChangedSignature, float, CurrentHP, float, MaxHP);
 
@@ -23,6 +25,9 @@ class EPICWIZARDGAME_API AWizardCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	/** Records and injects input on our input actions */
+	friend class UInputReplaySubsystem;
+
 	/** First person camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	UCameraComponent* FirstPersonCamera;
@@ -43,6 +48,10 @@ class EPICWIZARDGAME_API AWizardCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	USkeletalMeshComponent* FirstPersonMesh;
 
+	/** Spell instances and cooldowns for the hotbar slots */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	USpellbookComponent* Spellbook;
+
 	/** Staff mesh attached to right hand */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	UStaticMeshComponent* StaffMesh;
@@ -148,6 +157,36 @@ protected:
 	/** True if currently casting a spell (prevents animation cancelling) */
 	bool bIsCasting = false;
 
+	/** How long a cast press stays buffered while the spell is on cooldown or the cast animation is playing (seconds) */
+	UPROPERTY(EditAnywhere, Category="Casting", meta=(ClampMin="0.0"))
+	float CastBufferWindow = 0.25f;
+
+	/** Most cast presses held in the buffer at once */
+	UPROPERTY(EditAnywhere, Category="Casting", meta=(ClampMin="1"))
+	int32 MaxBufferedCasts = 2;
+
+	/** A cast press waiting to fire */
+	struct FCastIntent
+	{
+		/** World time when the input arrived, on the same clock as the spellbook cooldowns */
+		double Timestamp;
+
+		/** Platform time when the input arrived, only for measuring input-to-cast latency */
+		double InputTime;
+
+		/** Hotbar slot that was selected when the input arrived */
+		int32 SlotIndex;
+	};
+
+	/** Pending cast presses, oldest first */
+	TArray<FCastIntent> CastBuffer;
+
+	/** Input-to-cast time of the last buffered cast (milliseconds) */
+	float LastCastLatencyMs = 0.0f;
+
+	/** Where the wizard started, used when the run restarts in place */
+	FTransform SpawnTransform;
+
 	/** True when using the top-down view (courtyard/rampart levels) */
 	bool bIsTopDownViewActive = false;
 
@@ -179,6 +218,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Wizard")
 	bool IsCasting() const { return bIsCasting; }
 
+	/** Bring the wizard back to full health at its spawn point for a restarted run */
+	void ResetForRestart();
+
+	/** Input-to-cast time of the last buffered cast in milliseconds */
+	UFUNCTION(BlueprintPure, Category="Wizard")
+	float GetLastCastLatencyMs() const { return LastCastLatencyMs; }
+
 	/** Returns the first person camera */
 	UCameraComponent* GetFirstPersonCamera() const { return FirstPersonCamera; }
 
@@ -188,6 +234,9 @@ public:
 	/** Returns the staff mesh */
 	UStaticMeshComponent* GetStaffMesh() const { return StaffMesh; }
 
+	/** Returns the spellbook */
+	USpellbookComponent* GetSpellbook() const { return Spellbook; }
+
 	/** Returns current HP percentage (0-1) */
 	UFUNCTION(BlueprintCallable, Category="Wizard")
 	float GetHealthPercent() const { return MaxHP > 0.0f ? CurrentHP / MaxHP : 0.0f; }
@@ -221,6 +270,15 @@ protected:
 	void SelectHotbarSlot4();
 	void SelectHotbarSlot5();
 
+	/** Record a cast press for a spell slot */
+	void BufferCastIntent(int32 SlotIndex);
+
+	/** Fire the oldest buffered press if its spell is ready and no cast animation is playing */
+	void TryFireBufferedCast();
+
+	/** Use the current hotbar slot, and play the cast animation if a spell was actually cast */
+	ESpellCastResult PerformCast();
+
 	/** Called when cast montage ends */
 	UFUNCTION()
 	void OnCastMontageEnded(UAnimMontage* Montage, bool bInterrupted);
@@ -247,6 +305,10 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Wizard", meta=(DisplayName="On Death"))
 	void BP_OnDeath();
 
+	/** Blueprint event when a run restart or wave rollback brings the wizard back in place; undo whatever On Death changed */
+	UFUNCTION(BlueprintImplementableEvent, Category="Wizard", meta=(DisplayName="On Run Restarted"))
+	void BP_OnRunRestarted();
+
 private:
 	void UpdateMovementAnimation();
 
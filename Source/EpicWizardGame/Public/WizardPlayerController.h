@@ -8,6 +8,8 @@
 
 class UHotbarWidget;
 class UDeathScreenWidget;
+class SHealthBarOverlay;
+class UCursorTraceComponent;
 
 /**
  * Player controller for the Wizard character
@@ -29,10 +31,27 @@ public:
 	UFUNCTION(BlueprintPure, Category="UI")
 	UHotbarWidget* GetHotbarWidget() const { return HotbarWidget; }
 
+	/** Restart the run in place, or reload the level if it has no wave manager */
+	UFUNCTION(BlueprintCallable, Category="Game")
+	void RestartRun();
+
+	/** Roll the run back to the start of the current wave */
+	UFUNCTION(BlueprintCallable, Category="Game")
+	void RetryWave();
+
+	/** Get the shared per-frame cursor trace */
+	UCursorTraceComponent* GetCursorTrace() const { return CursorTrace; }
+
 protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Cursor trace shared by aiming and turret placement */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UCursorTraceComponent* CursorTrace;
+
 	/** Reference to the hotbar widget */
 	UPROPERTY()
 	UHotbarWidget* HotbarWidget;
@@ -40,4 +59,20 @@ protected:
 	/** Reference to the death screen widget (only used on the DeathScreen level) */
 	UPROPERTY()
 	UDeathScreenWidget* DeathScreenWidget;
+
+	/** HUD layer drawing every floating health bar (gameplay levels only) */
+	TSharedPtr<SHealthBarOverlay> HealthBarOverlay;
+
+	/** Game input with a free, visible cursor for top-down aiming */
+	void ApplyGameplayInputMode();
+
+	/** Show the death UI over the running world */
+	void OnRunLost();
+
+	/** Hide the death UI and hand input back to the game */
+	void OnRunRestarted();
+
+	/** Event bus subscriptions */
+	FDelegateHandle RunLostHandle;
+	FDelegateHandle RunRestartedHandle;
 };
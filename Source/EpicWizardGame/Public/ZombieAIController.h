@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "GameplayTimerWheel.h"
 #include "ZombieAIController.generated.h"
 
 class AZombieCharacter;
+class UAttackSlotComponent;
 
 /**
  * AI Controller for the Zombie enemy
@@ -31,16 +33,72 @@ protected:
 	UPROPERTY(EditAnywhere, Category="AI")
 	float AcceptanceRadius = 50.0f;
 
-	/** Timer for AI updates */
-	FTimerHandle AIUpdateTimer;
+	/** Acceptance radius when walking to a reserved attack slot */
+	UPROPERTY(EditAnywhere, Category="AI|Attack Slots")
+	float SlotAcceptanceRadius = 30.0f;
+
+	/** How far a slot or queue goal may drift before the move is re-issued */
+	UPROPERTY(EditAnywhere, Category="AI|Attack Slots")
+	float SlotRepathTolerance = 100.0f;
+
+	/** Let nearby zombies chasing the same target share one leader's path. Off by default; opt in per zombie Blueprint */
+	UPROPERTY(EditAnywhere, Category="AI|Squads")
+	bool bUseSquads = false;
+
+	/** How close a zombie must be to a squad leader to join its squad */
+	UPROPERTY(EditAnywhere, Category="AI|Squads", meta=(ClampMin="0.0", EditCondition="bUseSquads"))
+	float SquadJoinRadius = 600.0f;
+
+	/** Largest squad, leader included */
+	UPROPERTY(EditAnywhere, Category="AI|Squads", meta=(ClampMin="2", EditCondition="bUseSquads"))
+	int32 MaxSquadSize = 8;
+
+	/** Spacing between formation positions */
+	UPROPERTY(EditAnywhere, Category="AI|Squads", meta=(ClampMin="10.0", EditCondition="bUseSquads"))
+	float SquadFormationSpacing = 120.0f;
+
+	/** Followers further than this from their leader split off and path on their own */
+	UPROPERTY(EditAnywhere, Category="AI|Squads", meta=(ClampMin="0.0", EditCondition="bUseSquads"))
+	float SquadSplitDistance = 900.0f;
+
+	/** Within this distance of the target squads break up so everyone can attack */
+	UPROPERTY(EditAnywhere, Category="AI|Squads", meta=(ClampMin="0.0", EditCondition="bUseSquads"))
+	float SquadBreakDistance = 800.0f;
+
+	/** Timer for AI updates (on the gameplay timer wheel) */
+	FGameplayTimerHandle AIUpdateTimer;
 
 	/** Cached reference to zombie character */
 	TObjectPtr<AZombieCharacter> ZombieCharacter;
 
+	/** Target picked by the last AI update */
+	TWeakObjectPtr<AActor> CurrentTarget;
+
+	/** Slot allocator we hold a reservation (or queue spot) with */
+	TWeakObjectPtr<UAttackSlotComponent> ReservedSlots;
+
+	/** Slot index we hold, INDEX_NONE while queued */
+	int32 ReservedSlotIndex = INDEX_NONE;
+
+	/** Goal of the last slot/queue move we issued */
+	FVector SlotMoveGoal = FVector::ZeroVector;
+
+	/** True while the current move request targets SlotMoveGoal */
+	bool bHasSlotMove = false;
+
+	/** Event bus subscription for navmesh rebuilds */
+	FDelegateHandle NavMeshRebuiltHandle;
+
 public:
 
 	AZombieAIController();
 
+	/** Returns time spent in UpdateAI across all zombies since the last call (milliseconds) */
+	static double ConsumeUpdateTimeMs();
+
+	/** Returns the target picked by the last AI update */
+	AActor* GetCurrentTarget() const { return CurrentTarget.Get(); }
+
 protected:
 
 	virtual void OnPossess(APawn* InPawn) override;
@@ -53,4 +111,24 @@ protected:
 	/** Called when zombie dies */
 	UFUNCTION()
 	void OnZombieDeath();
+
+	/** Trail the squad leader if we are a follower. Returns false if we should think for ourselves */
+	bool UpdateAsSquadFollower();
+
+	/** Leave our squad, if any */
+	void LeaveSquad();
+
+	/** Give back any attack slot or queue spot we hold */
+	void ReleaseAttackSlot();
+
+	/** Turret obstacles changed the navmesh; drop cached moves so the next update repaths */
+	void OnNavMeshRebuilt();
+
+	/** Move to the reserved slot, or to the queue position while waiting for one */
+	void MoveToAttackSlot(UAttackSlotComponent* Slots);
+
+private:
+
+	/** UpdateAI time accumulated across all zombies, drained by the spawn manager's adaptive cap */
+	static double AccumulatedUpdateTimeMs;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayTimerWheel.h"
 #include "ZombieCharacter.generated.h"
 
 class UAnimMontage;
@@ -11,6 +12,7 @@ class UAnimSequenceBase;
 class UAnimInstance;
 class USkeletalMeshComponent;
 class UWidgetComponent;
+class UZombieSpatialGridSubsystem;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FZombieDeathDelegate);
 
@@ -31,25 +33,36 @@ public:
 
 protected:
 
-	/** Floating health bar widget */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
-	UWidgetComponent* HealthBarWidget;
+	/** Deprecated: floating health bars are drawn by UHealthBarSubsystem now. Always null; kept for one release so Blueprints reading it still compile */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(DeprecatedProperty, DeprecationMessage="Health bars are drawn by the health bar subsystem; this is always None"))
+	UWidgetComponent* HealthBarWidget = nullptr;
+
+	/** Height of the floating health bar above the actor origin */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	float HealthBarHeight = 100.0f;
+
+	/** Size of the floating health bar on screen */
+	UPROPERTY(EditAnywhere, Category="Health Bar")
+	FVector2D HealthBarSize = FVector2D(80.0f, 8.0f);
+
+	/** Handle of our bar in the health bar registry */
+	int32 HealthBarHandle = INDEX_NONE;
 
 	/** Attack animation montage */
 	UPROPERTY(EditAnywhere, Category="Animations")
 	UAnimMontage* AttackMontage;
 
-	/** Attack animation sequence (alternative to montage) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Animations")
-	UAnimSequenceBase* AttackAnimation;
+	/** Attack animation sequence (alternative to montage); soft so it loads with the wave preload. Blueprints use Get/SetAttackAnimation */
+	UPROPERTY(EditAnywhere, Category="Animations")
+	TSoftObjectPtr<UAnimSequenceBase> AttackAnimation;
 
 	/** Play rate for the attack animation sequence */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Animations", meta=(ClampMin="0.01", UIMin="0.1", UIMax="3.0"))
 	float AttackAnimPlayRate = 1.0f;
 
-	/** Walk loop animation (played when moving) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Animations")
-	UAnimSequenceBase* WalkAnimation;
+	/** Walk loop animation (played when moving); soft so it loads with the wave preload. Blueprints use Get/SetWalkAnimation */
+	UPROPERTY(EditAnywhere, Category="Animations")
+	TSoftObjectPtr<UAnimSequenceBase> WalkAnimation;
 
 	/** Play rate for the walk loop */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Animations", meta=(ClampMin="0.01", UIMin="0.1", UIMax="3.0"))
@@ -71,6 +84,22 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Combat")
 	float TowerAttackRange = 1000.0f;
 
+	/** Stop zombies blocking each other's capsules and spread them out with separation steering instead */
+	UPROPERTY(EditAnywhere, Category="Movement|Separation")
+	bool bUseSeparationSteering = false;
+
+	/** Other zombies closer than this push us away */
+	UPROPERTY(EditAnywhere, Category="Movement|Separation", meta=(ClampMin="1.0", EditCondition="bUseSeparationSteering"))
+	float SeparationRadius = 90.0f;
+
+	/** Speed of the separation push at full overlap (cm/s) */
+	UPROPERTY(EditAnywhere, Category="Movement|Separation", meta=(ClampMin="0.0", EditCondition="bUseSeparationSteering"))
+	float SeparationSpeed = 150.0f;
+
+	/** Most neighbours considered per update, keeps cost flat inside very dense clumps */
+	UPROPERTY(EditAnywhere, Category="Movement|Separation", meta=(ClampMin="1", EditCondition="bUseSeparationSteering"))
+	int32 MaxSeparationNeighbors = 8;
+
 	/** Time to wait after death before destroying */
 	UPROPERTY(EditAnywhere, Category="Death")
 	float DeathDestroyDelay = 5.0f;
@@ -81,8 +110,14 @@ protected:
 	/** True if dead */
 	bool bIsDead = false;
 
-	/** Timer for deferred destruction */
-	FTimerHandle DeathTimer;
+	/** Timer for deferred destruction (on the gameplay timer wheel) */
+	FGameplayTimerHandle DeathTimer;
+
+	/** Actor behind the most recent hit (a projectile, a turret or a spell), the killer once we're dead */
+	TWeakObjectPtr<AActor> LastDamageCauser;
+
+	/** Structures whose attack box we are currently inside (fed by the structures' overlap events) */
+	TSet<TWeakObjectPtr<AActor>> TouchingStructures;
 
 public:
 
@@ -121,6 +156,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Zombie")
 	float GetHealthPercent() const { return MaxHP > 0.0f ? CurrentHP / MaxHP : 0.0f; }
 
+	/** Actor behind the most recent hit; during OnZombieDied this is what killed us */
+	AActor* GetLastDamageCauser() const { return LastDamageCauser.Get(); }
+
+	/** Called by a tower/turret when we enter its attack box */
+	void AddTouchingStructure(AActor* Structure) { TouchingStructures.Add(Structure); }
+
+	/** Called by a tower/turret when we leave its attack box */
+	void RemoveTouchingStructure(AActor* Structure) { TouchingStructures.Remove(Structure); }
+
+	/** Returns true if we are inside the structure's attack box */
+	bool IsTouchingStructure(AActor* Structure) const { return TouchingStructures.Contains(Structure); }
+
+	/** Add the mesh and animations a spawned zombie plays, called on the CDO to preload them before a wave */
+	void GetAssetsToPreload(TArray<FSoftObjectPath>& OutAssets) const;
+
+	/** AttackAnimation, loaded on the spot if the wave preload didn't already bring it in */
+	UFUNCTION(BlueprintPure, Category="Animations")
+	UAnimSequenceBase* GetAttackAnimation() const;
+
+	UFUNCTION(BlueprintCallable, Category="Animations")
+	void SetAttackAnimation(UAnimSequenceBase* NewAnimation);
+
+	/** WalkAnimation, loaded on the spot if the wave preload didn't already bring it in */
+	UFUNCTION(BlueprintPure, Category="Animations")
+	UAnimSequenceBase* GetWalkAnimation() const;
+
+	UFUNCTION(BlueprintCallable, Category="Animations")
+	void SetWalkAnimation(UAnimSequenceBase* NewAnimation);
+
 protected:
 
 	/** Called when attack montage ends */
@@ -150,6 +214,15 @@ protected:
 private:
 	void UpdateMovementAnimation();
 
+	/** Push our HP ratio to the health bar registry */
+	void UpdateHealthBar();
+
+	/** Push away from nearby zombies found in the spatial grid */
+	void ApplySeparationSteering(float DeltaTime);
+
+	/** Grid we registered with */
+	TWeakObjectPtr<UZombieSpatialGridSubsystem> SpatialGrid;
+
 	UPROPERTY(Transient)
 	bool bUsingSingleNodeWalk = false;
 
@@ -174,6 +247,6 @@ private:
 	UPROPERTY(Transient)
 	TEnumAsByte<EAnimationMode::Type> SavedAttackAnimMode;
 
-	UPROPERTY(Transient)
-	FTimerHandle AttackAnimationTimer;
+	/** Ends a single-node attack animation (on the gameplay timer wheel) */
+	FGameplayTimerHandle AttackAnimationTimer;
 };
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ZombieSpatialGridSubsystem.generated.h"
+
+class AZombieCharacter;
+
+/**
+ * Uniform hash grid of living zombies, rebuilt once per frame.
+ * Lets neighbour queries scale with local density instead of the total zombie count.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UZombieSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Edge length of a grid cell in world units */
+	static constexpr float CellSize = 200.0f;
+
+	/** Add a zombie to the grid (it shows up in queries after the next rebuild) */
+	void RegisterZombie(AZombieCharacter* Zombie);
+
+	/** Remove a zombie from the grid */
+	void UnregisterZombie(AZombieCharacter* Zombie);
+
+	/** Collect living zombies within Radius of Location, using positions from the last rebuild. Works with any allocator (e.g. TScratchArray) */
+	template<typename AllocatorType>
+	void QueryRadius(const FVector& Location, float Radius, TArray<AZombieCharacter*, AllocatorType>& OutZombies) const
+	{
+		ForEachInRadius(Location, Radius, [&OutZombies](AZombieCharacter* Zombie)
+		{
+			OutZombies.Add(Zombie);
+		});
+	}
+
+	/** Visit living zombies within Radius of Location, using positions from the last rebuild */
+	void ForEachInRadius(const FVector& Location, float Radius, TFunctionRef<void(AZombieCharacter*)> Visitor) const;
+
+	/** Number of zombies currently registered */
+	int32 GetNumZombies() const { return Zombies.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** One zombie in a cell bucket */
+	struct FGridEntry
+	{
+		TWeakObjectPtr<AZombieCharacter> Zombie;
+		FVector Location;
+	};
+
+	/** Re-bucket every registered zombie from its current location */
+	void RebuildGrid();
+
+	/** Returns the cell containing a location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/** Registered zombies */
+	TArray<TWeakObjectPtr<AZombieCharacter>> Zombies;
+
+	/** Zombie buckets keyed by cell (buckets are emptied, not freed, between rebuilds) */
+	TMap<FIntPoint, TArray<FGridEntry>> Cells;
+};
@@ -29,9 +29,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category="Components")
 	UArrowComponent* SpawnDirection;
 
-	/** Zombie class to spawn */
+	/** Zombie class to spawn; soft so the level doesn't pull it in, the wave manager preloads it */
 	UPROPERTY(EditAnywhere, Category="Spawning")
-	TSubclassOf<AZombieCharacter> ZombieClass;
+	TSoftClassPtr<AZombieCharacter> ZombieClass;
 
 	/** Maximum number of zombies this gate can have alive at once */
 	UPROPERTY(EditAnywhere, Category="Spawning", meta=(ClampMin="1"))
@@ -41,6 +41,9 @@ protected:
 	UPROPERTY()
 	TArray<AZombieCharacter*> ActiveZombies;
 
+	/** Drives spawn positions inside the box, seeded by the spawn manager so a wave replays identically */
+	FRandomStream SpawnStream;
+
 public:
 
 	// Sets default values for this actor's properties
@@ -51,6 +54,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 
 	// Called every frame
@@ -72,11 +77,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Spawning")
 	int32 GetMaxActiveZombies() const { return MaxActiveZombiesPerGate; }
 
+	/** Zombie class this gate spawns */
+	const TSoftClassPtr<AZombieCharacter>& GetZombieClass() const { return ZombieClass; }
+
+	/** Reseed the spawn position stream */
+	void SetRandomSeed(int32 Seed) { SpawnStream.Initialize(Seed); }
+
 protected:
 
-	/** Called when a spawned zombie dies */
-	UFUNCTION()
-	void OnZombieDied();
+	/** Called when any zombie dies (via the gameplay event bus) */
+	void OnZombieDied(AZombieCharacter* Zombie);
+
+	/** Our subscription to zombie deaths on the event bus */
+	FDelegateHandle ZombieDiedHandle;
 
 	/** Clean up null references from the active zombies array */
 	void CleanupDeadZombies();
@@ -17,10 +17,50 @@ class EPICWIZARDGAME_API AZombieSpawnManager : public AActor
 
 public:
 
-	/** Maximum total number of zombies allowed at once across all gates */
+	/** Maximum total number of zombies allowed at once across all gates (used when the adaptive cap is off) */
 	UPROPERTY(EditAnywhere, Category="Spawning")
 	int32 MaxTotalZombies = 20;
 
+	/** Let measured frame cost raise or lower the live zombie cap between the bounds below */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap")
+	bool bUseAdaptiveZombieCap = false;
+
+	/** Lowest live zombie cap the adaptive controller may drop to */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="1", EditCondition="bUseAdaptiveZombieCap"))
+	int32 MinAdaptiveZombieCap = 10;
+
+	/** Highest live zombie cap the adaptive controller may raise to */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="1", EditCondition="bUseAdaptiveZombieCap"))
+	int32 MaxAdaptiveZombieCap = 60;
+
+	/** Game thread budget per frame (milliseconds) */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="1.0", EditCondition="bUseAdaptiveZombieCap"))
+	float GameThreadBudgetMs = 12.0f;
+
+	/** Zombie AI budget per frame (milliseconds) */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="0.1", EditCondition="bUseAdaptiveZombieCap"))
+	float AIBudgetMs = 2.0f;
+
+	/** Cap is raised only while both costs stay below this fraction of their budget */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="0.1", ClampMax="1.0", EditCondition="bUseAdaptiveZombieCap"))
+	float RaiseCapBelowBudgetFraction = 0.8f;
+
+	/** Cap is lowered once either cost goes above this fraction of its budget */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="1.0", ClampMax="2.0", EditCondition="bUseAdaptiveZombieCap"))
+	float LowerCapAboveBudgetFraction = 1.05f;
+
+	/** Seconds between cap adjustments */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="0.1", EditCondition="bUseAdaptiveZombieCap"))
+	float AdaptiveCapInterval = 1.0f;
+
+	/** How many zombies the cap moves per adjustment */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="1", EditCondition="bUseAdaptiveZombieCap"))
+	int32 AdaptiveCapStep = 2;
+
+	/** Smoothing for the frame cost averages (higher reacts faster) */
+	UPROPERTY(EditAnywhere, Category="Spawning|Adaptive Cap", meta=(ClampMin="0.01", ClampMax="1.0", EditCondition="bUseAdaptiveZombieCap"))
+	float FrameCostSmoothing = 0.1f;
+
 	/** Total zombies to spawn this wave (set by wave manager) */
 	UPROPERTY(BlueprintReadWrite, Category="Spawning")
 	int32 TotalZombiesToSpawn = 0;
@@ -60,6 +100,27 @@ protected:
 	/** Is spawning active */
 	bool bIsSpawning = false;
 
+	/** Live zombie cap chosen by the adaptive controller */
+	int32 AdaptiveZombieCap = 0;
+
+	/** Smoothed game thread cost per frame (milliseconds) */
+	float SmoothedGameThreadMs = 0.0f;
+
+	/** Smoothed zombie AI cost per frame (milliseconds) */
+	float SmoothedAIMs = 0.0f;
+
+	/** Time since the adaptive cap last moved */
+	float TimeSinceCapAdjustment = 0.0f;
+
+	/** Our subscription to zombie deaths on the event bus */
+	FDelegateHandle ZombieDiedHandle;
+
+	/** Drives gate selection; reseeded by the wave manager at each wave start */
+	FRandomStream GateStream;
+
+	/** Seed the streams were last initialized with */
+	int32 RandomSeed = 0;
+
 public:
 
 	// Sets default values for this actor's properties
@@ -70,6 +131,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 
 	// Called every frame
@@ -87,9 +150,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Spawning")
 	int32 GetTotalZombieCount() const { return ActiveZombies.Num(); }
 
-	/** Get max total zombies allowed */
+	/** Get number of spawned zombies that are still alive */
+	UFUNCTION(BlueprintCallable, Category="Spawning")
+	int32 GetAliveZombieCount() const;
+
+	/** Stop spawning and remove every zombie, for a restarted run */
 	UFUNCTION(BlueprintCallable, Category="Spawning")
-	int32 GetMaxTotalZombies() const { return MaxTotalZombies; }
+	void DespawnAllZombies();
+
+	/** All spawn gates found in the level */
+	const TArray<AZombieSpawnGate*>& GetSpawnGates() const { return SpawnGates; }
+
+	/** Reseed gate selection and every gate's spawn positions, so the same seed replays the same spawns */
+	void SetRandomSeed(int32 Seed);
+
+	/** Seed the spawn streams were last initialized with */
+	int32 GetRandomSeed() const { return RandomSeed; }
+
+	/** Get max total zombies allowed (the adaptive cap when enabled) */
+	UFUNCTION(BlueprintCallable, Category="Spawning")
+	int32 GetMaxTotalZombies() const { return bUseAdaptiveZombieCap ? AdaptiveZombieCap : MaxTotalZombies; }
 
 protected:
 
@@ -99,10 +179,12 @@ protected:
 	/** Called on timer to attempt spawning */
 	void TrySpawnZombie();
 
-	/** Called when a zombie dies */
-	UFUNCTION()
-	void OnZombieDied();
+	/** Called when a zombie dies (via the gameplay event bus) */
+	void OnZombieDied(AZombieCharacter* Zombie);
 
 	/** Clean up null references from active zombies */
 	void CleanupDeadZombies();
+
+	/** Sample this frame's cost and move the adaptive cap if it left the hysteresis band */
+	void UpdateAdaptiveCap(float DeltaTime);
 };
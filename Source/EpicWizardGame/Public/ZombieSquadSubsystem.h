@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ZombieSquadSubsystem.generated.h"
+
+class AZombieAIController;
+
+/**
+ * Groups nearby zombies chasing the same target into squads.
+ * The leader picks targets and pathfinds; followers trail it in formation without path queries.
+ */
+UCLASS()
+class EPICWIZARDGAME_API UZombieSquadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Join a nearby squad chasing the same target, or start a new one led by this zombie. Returns true if joined as a follower */
+	bool JoinOrFormSquad(AZombieAIController* Controller, AActor* Target, float JoinRadius, int32 MaxSquadSize);
+
+	/** Leave the current squad (a departing leader hands over to its first follower) */
+	void LeaveSquad(AZombieAIController* Controller);
+
+	/** Returns the squad leader if this zombie is a follower, otherwise nullptr */
+	AZombieAIController* GetSquadLeader(const AZombieAIController* Controller) const;
+
+	/** Returns true if this zombie is in any squad */
+	bool IsInSquad(const AZombieAIController* Controller) const { return SquadIds.Contains(Controller); }
+
+	/** Formation position for a follower, in rows behind the leader's heading */
+	bool GetFormationLocation(const AZombieAIController* Controller, float Spacing, FVector& OutLocation) const;
+
+private:
+
+	struct FZombieSquad
+	{
+		/** Zombie that picks the target and holds the real path */
+		TWeakObjectPtr<AZombieAIController> Leader;
+
+		/** Zombies trailing the leader, in formation order */
+		TArray<TWeakObjectPtr<AZombieAIController>> Followers;
+	};
+
+	/** Live squads by id */
+	TMap<int32, FZombieSquad> Squads;
+
+	/** Squad id of every member, leaders included */
+	TMap<TObjectKey<AZombieAIController>, int32> SquadIds;
+
+	/** Next id handed to a new squad */
+	int32 NextSquadId = 0;
+};
@@ -8,8 +8,24 @@
 #include "ShooterWeaponHolder.h"
 #include "ShooterWeapon.h"
 #include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/ConstructorHelpers.h"
 #include "TimerManager.h"
 
+namespace
+{
+	/** A weapon table row load and the pickups waiting for it */
+	struct FSharedWeaponLoad
+	{
+		TWeakPtr<FStreamableHandle> Handle;
+		TArray<TWeakObjectPtr<AShooterPickup>> PendingPickups;
+	};
+
+	/** One load per weapon table row, shared across all pickups of that row */
+	TMap<TPair<FObjectKey, FName>, FSharedWeaponLoad> SharedWeaponLoads;
+}
+
 AShooterPickup::AShooterPickup()
 {
  	PrimaryActorTick.bCanEverTick = true;
@@ -36,12 +52,25 @@ AShooterPickup::AShooterPickup()
 	Mesh->SetupAttachment(SphereCollision);
 
 	Mesh->SetCollisionProfileName(FName("NoCollision"));
+
+	// default placeholder shown until the weapon mesh streams in
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaceholderAsset(TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+	if (PlaceholderAsset.Succeeded())
+	{
+		PlaceholderMesh = PlaceholderAsset.Object;
+	}
 }
 
 void AShooterPickup::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
+	// game worlds load the mesh asynchronously from BeginPlay, only the editor preview loads it here
+	if (GetWorld() && GetWorld()->IsGameWorld())
+	{
+		return;
+	}
+
 	if (FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
 	{
 		// set the mesh
@@ -55,8 +84,104 @@ void AShooterPickup::BeginPlay()
 
 	if (FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
 	{
+		// show the placeholder and stay uncollectable until the weapon is loaded
+		if (!WeaponData->StaticMesh.IsValid() && PlaceholderMesh)
+		{
+			Mesh->SetStaticMesh(PlaceholderMesh);
+		}
+
+		SetActorEnableCollision(false);
+
+		RequestWeaponAssets(*WeaponData);
+	}
+}
+
+void AShooterPickup::RequestWeaponAssets(const FWeaponTableRow& WeaponData)
+{
+	const TPair<FObjectKey, FName> LoadKey(WeaponType.DataTable.Get(), WeaponType.RowName);
+	FSharedWeaponLoad& SharedLoad = SharedWeaponLoads.FindOrAdd(LoadKey);
+
+	// join a load that is still alive
+	WeaponLoadHandle = SharedLoad.Handle.Pin();
+	if (WeaponLoadHandle.IsValid())
+	{
+		if (WeaponLoadHandle->HasLoadCompleted())
+		{
+			OnWeaponAssetsLoaded();
+		}
+		else
+		{
+			SharedLoad.PendingPickups.Add(this);
+		}
+		return;
+	}
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	if (!WeaponData.StaticMesh.IsNull())
+	{
+		AssetsToLoad.Add(WeaponData.StaticMesh.ToSoftObjectPath());
+	}
+	if (!WeaponData.WeaponToSpawn.IsNull())
+	{
+		AssetsToLoad.Add(WeaponData.WeaponToSpawn.ToSoftObjectPath());
+	}
+
+	// register as waiting first, the completion delegate can run before RequestAsyncLoad returns
+	SharedLoad.PendingPickups.Add(this);
+
+	WeaponLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetsToLoad),
+		FStreamableDelegate::CreateStatic(&AShooterPickup::OnSharedWeaponLoadComplete, LoadKey.Key, LoadKey.Value));
+
+	// the map entry may have been touched by the callback, so look it up again
+	if (FSharedWeaponLoad* Load = SharedWeaponLoads.Find(LoadKey))
+	{
+		Load->Handle = WeaponLoadHandle;
+	}
+
+	// nothing to load, or a handle that completed without firing
+	if (!WeaponLoadHandle.IsValid() || WeaponLoadHandle->HasLoadCompleted())
+	{
+		OnSharedWeaponLoadComplete(LoadKey.Key, LoadKey.Value);
+	}
+}
+
+void AShooterPickup::OnSharedWeaponLoadComplete(FObjectKey DataTable, FName RowName)
+{
+	FSharedWeaponLoad* SharedLoad = SharedWeaponLoads.Find(TPair<FObjectKey, FName>(DataTable, RowName));
+	if (!SharedLoad)
+	{
+		return;
+	}
+
+	// notify everyone who was waiting
+	TArray<TWeakObjectPtr<AShooterPickup>> Pickups = MoveTemp(SharedLoad->PendingPickups);
+	for (const TWeakObjectPtr<AShooterPickup>& Pickup : Pickups)
+	{
+		if (Pickup.IsValid())
+		{
+			Pickup->OnWeaponAssetsLoaded();
+		}
+	}
+}
+
+void AShooterPickup::OnWeaponAssetsLoaded()
+{
+	if (FWeaponTableRow* WeaponData = WeaponType.GetRow<FWeaponTableRow>(FString()))
+	{
+		// swap the placeholder for the weapon mesh
+		if (UStaticMesh* WeaponMesh = WeaponData->StaticMesh.Get())
+		{
+			Mesh->SetStaticMesh(WeaponMesh);
+		}
+
 		// copy the weapon class
-		WeaponClass = WeaponData->WeaponToSpawn;
+		WeaponClass = WeaponData->WeaponToSpawn.Get();
+	}
+
+	// become collectable, unless we were picked up and are waiting to respawn
+	if (!IsHidden())
+	{
+		SetActorEnableCollision(true);
 	}
 }
 
@@ -66,6 +191,9 @@ void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	// clear the respawn timer
 	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// let go of the shared weapon load, it's released once the last pickup of the row is gone
+	WeaponLoadHandle.Reset();
 }
 
 void AShooterPickup::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -6,11 +6,13 @@
 #include "GameFramework/Actor.h"
 #include "Engine/DataTable.h"
 #include "Engine/StaticMesh.h"
+#include "UObject/ObjectKey.h"
 #include "ShooterPickup.generated.h"
 
 class USphereComponent;
 class UPrimitiveComponent;
 class AShooterWeapon;
+struct FStreamableHandle;
 
 /**
  *  Holds information about a type of weapon pickup
@@ -26,7 +28,7 @@ struct FWeaponTableRow : public FTableRowBase
 
 	/** Weapon class to grant on pickup */
 	UPROPERTY(EditAnywhere)
-	TSubclassOf<AShooterWeapon> WeaponToSpawn;
+	TSoftClassPtr<AShooterWeapon> WeaponToSpawn;
 };
 
 /**
@@ -51,8 +53,15 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Pickup")
 	FDataTableRowHandle WeaponType;
 
-	/** Type to weapon to grant on pickup. Set from the weapon data table. */
+	/** Type to weapon to grant on pickup. Set from the weapon data table once loaded. */
 	TSubclassOf<AShooterWeapon> WeaponClass;
+
+	/** Mesh shown while the weapon mesh and class are still loading */
+	UPROPERTY(EditAnywhere, Category="Pickup")
+	TObjectPtr<UStaticMesh> PlaceholderMesh;
+
+	/** Keeps the weapon assets loaded. Shared by all pickups of the same table row */
+	TSharedPtr<FStreamableHandle> WeaponLoadHandle;
 	
 	/** Time to wait before respawning this pickup */
 	UPROPERTY(EditAnywhere, Category="Pickup", meta = (ClampMin = 0, ClampMax = 120, Units = "s"))
@@ -77,6 +86,15 @@ protected:
 	/** Gameplay cleanup */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Requests the weapon mesh and class, joining any load already in flight for the same row */
+	void RequestWeaponAssets(const FWeaponTableRow& WeaponData);
+
+	/** Applies the loaded mesh and weapon class and makes the pickup collectable */
+	void OnWeaponAssetsLoaded();
+
+	/** Completion callback of a shared row load. Notifies every pickup waiting on it */
+	static void OnSharedWeaponLoadComplete(FObjectKey DataTable, FName RowName);
+
 	/** Handles collision overlap */
 	UFUNCTION()
 	virtual void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -6,6 +6,7 @@
 #include "Engine/World.h"
 #include "ShooterProjectile.h"
 #include "ShooterWeaponHolder.h"
+#include "GameplayRandomSubsystem.h"
 #include "Components/SceneComponent.h"
 #include "TimerManager.h"
 #include "Animation/AnimInstance.h"
@@ -200,8 +201,12 @@ FTransform AShooterWeapon::CalculateProjectileSpawnTransform(const FVector& Targ
 	// calculate the spawn location ahead of the muzzle
 	const FVector SpawnLoc = MuzzleLoc + ((TargetLocation - MuzzleLoc).GetSafeNormal() * MuzzleOffset);
 
-	// find the aim rotation vector while applying some variance to the target 
-	const FRotator AimRot = UKismetMathLibrary::FindLookAtRotation(SpawnLoc, TargetLocation + (UKismetMathLibrary::RandomUnitVector() * AimVariance));
+	// draw the variance from the seeded weapons stream so runs can be reproduced
+	UGameplayRandomSubsystem* Random = UGameplayRandomSubsystem::Get(this);
+	const FVector Variance = Random ? Random->GetStream(EGameplayRandomStream::Weapons).VRand() : UKismetMathLibrary::RandomUnitVector();
+
+	// find the aim rotation vector while applying some variance to the target
+	const FRotator AimRot = UKismetMathLibrary::FindLookAtRotation(SpawnLoc, TargetLocation + (Variance * AimVariance));
 
 	// return the built transform
 	return FTransform(AimRot, SpawnLoc, FVector::OneVector);